@@ -0,0 +1,125 @@
+/**
+ * Cache admission benchmark
+ *
+ * Replays a play_all-style request stream through the controller cache with
+ * and without the TinyLFU admission filter, the way
+ * DJControllerService::loadTrackToCache does (record, then on a miss that
+ * would evict ask the filter before cloning):
+ * - a rotation of HOT repeated tracks (the sets' anthems)
+ * - interleaved one-off tracks that are never requested again, at several
+ *   one-off shares of the stream
+ * The cache holds CAPACITY tracks, slightly more than the hot set. Reported
+ * per policy: hit rate and inserts (each insert is a clone + load on the
+ * demand path) without and with admission, and the rejected one-offs.
+ *
+ * Build and run:  make bench && ./bin/bench_admission
+ */
+#include "LRUCache.h"
+#include "TinyLFU.h"
+#include "AudioTrack.h"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t HOT = 24;
+const size_t CAPACITY = 32;
+const size_t REQUESTS = 200000;
+
+// Minimal concrete track: single-sample waveform, silent copies
+class BenchTrack : public AudioTrack {
+public:
+    explicit BenchTrack(const std::string& title)
+        : AudioTrack(title, std::vector<std::string>(1, "Bench"), 300, 128, 1) {}
+    void load() override {}
+    void analyze_beatgrid() override {}
+    double get_quality_score() const override { return 0.0; }
+    TrackFormat get_format() const override { return TrackFormat::WAV; }
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new BenchTrack(*this));
+    }
+};
+
+struct Result {
+    size_t hits;
+    size_t inserts;
+    size_t rejected;
+};
+
+// Request stream: one_off_share of requests are fresh titles, the rest cycle through the hot set
+std::vector<BenchTrack*> make_stream(double one_off_share, std::vector<BenchTrack*>& owned) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<size_t> hot_pick(0, HOT - 1);
+    std::vector<BenchTrack*> hot;
+    for (size_t i = 0; i < HOT; ++i) {
+        owned.push_back(new BenchTrack("Anthem " + std::to_string(i)));
+        hot.push_back(owned.back());
+    }
+    std::vector<BenchTrack*> stream;
+    stream.reserve(REQUESTS);
+    size_t one_offs = 0;
+    for (size_t i = 0; i < REQUESTS; ++i) {
+        if (coin(rng) < one_off_share) {
+            owned.push_back(new BenchTrack("One-off " + std::to_string(one_offs++)));
+            stream.push_back(owned.back());
+        } else {
+            stream.push_back(hot[hot_pick(rng)]);
+        }
+    }
+    return stream;
+}
+
+Result replay(const std::vector<BenchTrack*>& stream, const std::string& policy, bool filtered) {
+    LRUCache cache(CAPACITY);
+    cache.set_policy(EvictionPolicy::create(policy));
+    TinyLFU sketch(CAPACITY);
+    Result result = {0, 0, 0};
+    for (BenchTrack* track : stream) {
+        const std::string& title = track->get_title();
+        if (filtered) {
+            sketch.record(title);
+        }
+        if (cache.get(title)) {
+            ++result.hits;
+            continue;
+        }
+        if (filtered) {
+            const std::string* victim = cache.victimFor(*track);
+            if (victim && !sketch.admit(title, *victim)) {
+                ++result.rejected;
+                continue;
+            }
+        }
+        cache.put(track->clone());
+        ++result.inserts;
+    }
+    return result;
+}
+
+} // namespace
+
+int main() {
+    const char* policies[] = {"lru", "clock", "arc"};
+    const double shares[] = {0.1, 0.3, 0.5};
+    std::printf("hot tracks: %zu, capacity: %zu, requests: %zu, sketch: %zu bytes\n", HOT, CAPACITY,
+                REQUESTS, TinyLFU(CAPACITY).memory_bytes());
+    std::printf("%-6s %8s  %18s  %28s\n", "policy", "one-offs", "plain (hit, ins)", "tinylfu (hit, ins, rejected)");
+    for (double share : shares) {
+        std::vector<BenchTrack*> owned;
+        const std::vector<BenchTrack*> stream = make_stream(share, owned);
+        for (const char* policy : policies) {
+            const Result plain = replay(stream, policy, false);
+            const Result filtered = replay(stream, policy, true);
+            std::printf("%-6s %7.0f%%  %7.1f%% %9zu  %7.1f%% %9zu %9zu\n", policy, 100.0 * share,
+                        100.0 * plain.hits / REQUESTS, plain.inserts, 100.0 * filtered.hits / REQUESTS,
+                        filtered.inserts, filtered.rejected);
+        }
+        for (BenchTrack* track : owned) {
+            delete track;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * Heap allocation benchmark
+ *
+ * Runs a full play_all DJSession (the dj_manager -I -A path) with every heap
+ * allocation counted by a replaced global operator new, and splits the count
+ * at each "--- Processing:" line the session prints:
+ * - setup: configuration, library build and playlist resolution, before the
+ *   first track
+ * - per track: from one track's line to the next (cache load, cache status,
+ *   deck load and its clone, summaries between playlists), mean and maximum
+ * Console output goes to a counting stream buffer that allocates nothing, so
+ * only the session's own allocations are measured.
+ * Then the accessors the per-track paths call, against the by-value copies
+ * they replace: get_title(), get_artists() and get_artist_line().
+ *
+ * Build and run (from the repository root, which has bin/dj_config.txt, or
+ * pass a directory that does):  make bench && ./bin/bench_alloc [dir]
+ */
+#include "DJSession.h"
+#include "MP3Track.h"
+#include <unistd.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<size_t> allocations(0);
+
+// Discards output, recording the allocation count at each track's "--- Processing:" line
+class MarkerBuffer : public std::streambuf {
+private:
+    const char* marker;
+    size_t matched;
+    size_t* marks;
+    size_t capacity;
+    size_t count;
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+        const char c = traits_type::to_char_type(ch);
+        matched = (c == marker[matched]) ? matched + 1 : (c == marker[0] ? 1 : 0);
+        if (marker[matched] == '\0') {
+            if (count < capacity) marks[count] = allocations.load(std::memory_order_relaxed);
+            ++count;
+            matched = 0;
+        }
+        return ch;
+    }
+
+public:
+    MarkerBuffer(size_t* storage, size_t slots)
+        : std::streambuf(), marker("--- Processing:"), matched(0), marks(storage), capacity(slots), count(0) {}
+
+    MarkerBuffer(const MarkerBuffer&) = delete;
+    MarkerBuffer& operator=(const MarkerBuffer&) = delete;
+
+    size_t markers() const { return count < capacity ? count : capacity; }
+};
+
+template <typename Call>
+double allocations_per_call(Call call, size_t calls) {
+    const size_t before = allocations.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < calls; ++i) {
+        call();
+    }
+    return static_cast<double>(allocations.load(std::memory_order_relaxed) - before) / static_cast<double>(calls);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(size == 0 ? 1 : size)) return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && chdir(argv[1]) != 0) {
+        std::fprintf(stderr, "cannot enter %s\n", argv[1]);
+        return 1;
+    }
+
+    static size_t marks[1 << 16];
+    MarkerBuffer sink(marks, sizeof(marks) / sizeof(marks[0]));
+    std::streambuf* saved_out = std::cout.rdbuf(&sink);
+    std::streambuf* saved_err = std::cerr.rdbuf(&sink);
+    const size_t start = allocations.load(std::memory_order_relaxed);
+    {
+        DJSession session("Allocation Bench", true);
+        session.simulate_dj_performance();
+    }
+    const size_t end = allocations.load(std::memory_order_relaxed);
+    // Built while output is still discarded, so its construction line is not printed
+    const MP3Track track("Allocation Bench Track With A Long Title",
+                         std::vector<std::string>{"First Featured Artist", "Second Featured Artist"}, 300, 128, 320);
+    std::cout.rdbuf(saved_out);
+    std::cerr.rdbuf(saved_err);
+
+    const size_t tracks = sink.markers();
+    if (tracks == 0) {
+        std::printf("no tracks processed (is bin/dj_config.txt here?)\n");
+        return 1;
+    }
+    size_t widest = 0;
+    for (size_t i = 1; i < tracks; ++i) {
+        widest = std::max(widest, marks[i] - marks[i - 1]);
+    }
+    std::printf("%-34s %10zu\n", "tracks processed", tracks);
+    std::printf("%-34s %10zu\n", "allocations, whole session", end - start);
+    std::printf("%-34s %10zu\n", "  setup (before the first track)", marks[0] - start);
+    std::printf("%-34s %10.1f\n", "  per track, mean",
+                tracks > 1 ? static_cast<double>(marks[tracks - 1] - marks[0]) / static_cast<double>(tracks - 1) : 0.0);
+    std::printf("%-34s %10zu\n", "  per track, max", widest);
+    std::printf("%-34s %10zu\n", "  last track and teardown", end - marks[tracks - 1]);
+
+    // Per-call cost of the accessors on the per-track paths
+    size_t sink_size = 0;
+    const size_t calls = 100000;
+    std::printf("\n%-34s %10s\n", "accessor", "allocs/call");
+    std::printf("%-34s %10.2f\n", "get_title() by reference",
+                allocations_per_call([&]() { sink_size += track.get_title().size(); }, calls));
+    std::printf("%-34s %10.2f\n", "  title copied into a std::string",
+                allocations_per_call([&]() { std::string title = track.get_title(); sink_size += title.size(); }, calls));
+    std::printf("%-34s %10.2f\n", "get_artists() by reference",
+                allocations_per_call([&]() { sink_size += track.get_artists().size(); }, calls));
+    std::printf("%-34s %10.2f\n", "  artists copied to vector<string>",
+                allocations_per_call([&]() {
+                    std::vector<std::string> artists(track.get_artists().begin(), track.get_artists().end());
+                    sink_size += artists.size();
+                }, calls));
+    std::printf("%-34s %10.2f\n", "get_artist_line()",
+                allocations_per_call([&]() { sink_size += track.get_artist_line().size(); }, calls));
+    std::printf("%-34s %10.2f\n", "  artists joined per call",
+                allocations_per_call([&]() {
+                    std::string line;
+                    for (const std::string& artist : track.get_artists()) {
+                        if (!line.empty()) line += ", ";
+                        line += artist;
+                    }
+                    sink_size += line.size();
+                }, calls));
+    std::printf("(%zu)\n", sink_size);
+    return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * Waveform analysis kernel benchmark
+ *
+ * Runs WaveformAnalyzer over 1e6, 1e7 and 1e8 float64 samples (800 MB at the
+ * top size; pass a smaller maximum as the first argument) with every kernel
+ * variant the CPU supports, and compares each against the scalar reference:
+ * - ms per full analysis and throughput in GB/s
+ * - speedup over analyze_reference()
+ * - agreement: peak and zero crossings must match exactly, rms within 1e-9
+ *
+ * Build and run:  make bench && ./bin/bench_analysis [max_samples]
+ */
+#include "WaveformAnalyzer.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+bool agrees(const WaveformStats& a, const WaveformStats& b) {
+    return a.peak == b.peak && a.zero_crossing_rate == b.zero_crossing_rate &&
+           std::fabs(a.rms - b.rms) <= 1e-9 * b.rms &&
+           a.energy_envelope.size() == b.energy_envelope.size();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t max_samples = argc > 1 ? static_cast<size_t>(std::strtod(argv[1], nullptr)) : 100000000;
+    const WaveformAnalyzer::Isa variants[] = {WaveformAnalyzer::Isa::Scalar, WaveformAnalyzer::Isa::SSE2,
+                                              WaveformAnalyzer::Isa::AVX2};
+    std::printf("best kernel on this CPU: %s\n", WaveformAnalyzer::isa_name(WaveformAnalyzer::best_isa()));
+    std::printf("%12s %-10s %10s %8s %9s %6s\n", "samples", "kernel", "ms", "GB/s", "speedup", "match");
+
+    for (size_t samples = 1000000; samples <= max_samples; samples *= 10) {
+        std::vector<double> waveform(samples);
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<double> dis(-1.0, 1.0);
+        for (double& s : waveform) {
+            s = dis(gen);
+        }
+
+        double start = now_ms();
+        const WaveformStats reference = WaveformAnalyzer::analyze_reference(waveform.data(), samples);
+        const double reference_ms = now_ms() - start;
+        std::printf("%12zu %-10s %10.2f %8.2f %9s %6s\n", samples, "reference", reference_ms,
+                    samples * sizeof(double) / (reference_ms * 1e6), "1.00x", "-");
+
+        for (WaveformAnalyzer::Isa isa : variants) {
+            if (static_cast<int>(isa) > static_cast<int>(WaveformAnalyzer::best_isa())) continue;
+            WaveformAnalyzer::set_isa(isa);
+            start = now_ms();
+            const WaveformStats stats = WaveformAnalyzer::analyze(waveform.data(), samples);
+            const double ms = now_ms() - start;
+            std::printf("%12zu %-10s %10.2f %8.2f %8.2fx %6s\n", samples, WaveformAnalyzer::isa_name(isa), ms,
+                        samples * sizeof(double) / (ms * 1e6), reference_ms / ms,
+                        agrees(stats, reference) ? "yes" : "NO");
+        }
+    }
+    WaveformAnalyzer::set_isa(WaveformAnalyzer::best_isa());
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * Beat detection benchmark
+ *
+ * Synthesises click tracks (a decaying 1 kHz burst on every beat over quiet
+ * noise, 22.05 kHz) at known tempos and lengths from 30 s to 30 min, then:
+ * - runs BeatDetector::detect and reports the tempo found, confidence and time
+ * - reports time per minute of audio (flat if the pipeline scales as n log n)
+ * - compares one STFT frame through FFT against a direct O(N^2) DFT
+ * - times a second detect on a clone, which must hit the per-track memo
+ *
+ * Build and run:  make bench && ./bin/bench_beats
+ */
+#include "AudioTrack.h"
+#include "BeatDetector.h"
+#include "FFT.h"
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const double SAMPLE_RATE = 22050.0;
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+std::vector<double> click_track(double bpm, double seconds) {
+    const double pi = std::acos(-1.0);
+    std::vector<double> samples(static_cast<size_t>(seconds * SAMPLE_RATE));
+    std::mt19937 gen(3);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    for (double& s : samples) {
+        s = noise(gen);
+    }
+    const double beat = 60.0 / bpm;
+    for (double t = 0.25; t < seconds; t += beat) {
+        const size_t start = static_cast<size_t>(t * SAMPLE_RATE);
+        for (size_t i = 0; i < 1000 && start + i < samples.size(); ++i) {
+            const double time = i / SAMPLE_RATE;
+            samples[start + i] += 0.8 * std::exp(-time * 60.0) * std::sin(2.0 * pi * 1000.0 * time);
+        }
+    }
+    return samples;
+}
+
+// Track whose waveform is loaded from a synthetic signal instead of generated
+class BenchTrack : public AudioTrack {
+public:
+    BenchTrack(const std::vector<double>& samples, int seconds)
+        : AudioTrack("Bench Click Track", std::vector<std::string>(1, "Bench"), seconds, 120, samples.size()) {
+        write_waveform(0, samples.data(), samples.size());
+    }
+    void load() override {}
+    void analyze_beatgrid() override {}
+    double get_quality_score() const override { return 0.0; }
+    TrackFormat get_format() const override { return TrackFormat::WAV; }
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new BenchTrack(*this));
+    }
+};
+
+void compare_frame_transform(size_t frame) {
+    const double pi = std::acos(-1.0);
+    std::vector<std::complex<double> > data(frame);
+    std::vector<std::complex<double> > out(frame);
+    for (size_t i = 0; i < frame; ++i) data[i] = std::complex<double>(std::sin(0.1 * i), 0.0);
+
+    const FFT fft(frame);
+    const int reps = 200;
+    double start = now_ms();
+    for (int r = 0; r < reps; ++r) {
+        std::vector<std::complex<double> > work(data);
+        fft.forward(work.data());
+    }
+    const double fft_us = (now_ms() - start) * 1000.0 / reps;
+
+    start = now_ms();
+    for (int r = 0; r < 4; ++r) {
+        for (size_t k = 0; k < frame; ++k) {
+            std::complex<double> sum(0.0, 0.0);
+            for (size_t n = 0; n < frame; ++n) {
+                const double angle = -2.0 * pi * static_cast<double>(k * n % frame) / frame;
+                sum += data[n] * std::complex<double>(std::cos(angle), std::sin(angle));
+            }
+            out[k] = sum;
+        }
+    }
+    const double dft_us = (now_ms() - start) * 1000.0 / 4;
+    std::printf("one %zu-point frame: FFT %.1f us, direct DFT %.1f us (%.0fx)\n",
+                frame, fft_us, dft_us, dft_us / fft_us);
+}
+
+} // namespace
+
+int main() {
+    const double tempos[] = {90.0, 128.0, 174.0};
+    const double lengths[] = {30.0, 300.0, 1800.0};
+
+    std::printf("%8s %8s %10s %10s %10s %12s\n", "bpm", "seconds", "detected", "confidence",
+                "ms", "ms/minute");
+    for (double seconds : lengths) {
+        for (double bpm : tempos) {
+            std::vector<double> samples = click_track(bpm, seconds);
+            const double start = now_ms();
+            const BeatGrid grid = BeatDetector::detect(samples.data(), samples.size(), SAMPLE_RATE);
+            const double ms = now_ms() - start;
+            std::printf("%8.1f %8.0f %10.1f %10.2f %10.1f %12.2f\n", bpm, seconds,
+                        grid.detected ? grid.bpm : 0.0, grid.confidence, ms, ms / (seconds / 60.0));
+        }
+    }
+
+    compare_frame_transform(1024);
+
+    BenchTrack track(click_track(128.0, 300.0), 300);
+    double start = now_ms();
+    const double first_bpm = track.get_beat_grid().bpm;
+    const double first_ms = now_ms() - start;
+    PointerWrapper<AudioTrack> clone = track.clone();
+    start = now_ms();
+    const double clone_bpm = clone->get_beat_grid().bpm;
+    const double clone_ms = now_ms() - start;
+    std::printf("5 min track: first analysis %.1f ms (%.1f BPM), clone %.4f ms (%.1f BPM, memoised)\n",
+                first_ms, first_bpm, clone_ms, clone_bpm);
+    return 0;
+}
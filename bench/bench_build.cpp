@@ -0,0 +1,89 @@
+/**
+ * Parallel library build benchmark
+ *
+ * Builds a library from a synthetic config of N tracks (default 1M,
+ * alternating MP3/WAV) with 1, 2, 4 and 8 build threads, with and without
+ * per-track construction logging, and reports the speed-up over one thread.
+ * Logging output goes to a null buffer, so the buffered path is still paid
+ * but nothing reaches the terminal. Each build also checks that track i of
+ * the config is library track i + 1.
+ *
+ * Build and run:  make bench && ./bin/bench_build [tracks]
+ */
+#include "DJLibraryService.h"
+#include "SessionFileParser.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+double build_once(const std::vector<SessionConfig::TrackInfo>& infos, size_t threads, bool logging,
+                  bool& ordered) {
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    double ms = 0.0;
+    {
+        DJLibraryService library;
+        library.set_build_threads(threads);
+        library.set_build_logging(logging);
+        const double start = now_ms();
+        library.buildLibrary(infos);
+        ms = now_ms() - start;
+        // Spot-check index order: every 997th entry must be where the config put it
+        ordered = true;
+        for (size_t i = 0; i < infos.size(); i += 997) {
+            AudioTrack* track = library.findLibraryTrack(infos[i].title);
+            ordered = ordered && track && track->get_duration() == infos[i].duration_seconds;
+        }
+    }
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+    return ms;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t tracks = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+    std::vector<SessionConfig::TrackInfo> infos(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        SessionConfig::TrackInfo& info = infos[i];
+        info.type = (i % 2 == 0) ? "MP3" : "WAV";
+        info.title = "Library Track " + std::to_string(i + 1);
+        info.artists.push_back("Artist " + std::to_string(i % 1000));
+        info.duration_seconds = 180 + static_cast<int>(i % 240);
+        info.bpm = 90 + static_cast<int>(i % 60);
+        info.extra_param1 = (i % 2 == 0) ? 320 : 44100;
+        info.extra_param2 = (i % 2 == 0) ? 1 : 16;
+    }
+
+    std::printf("tracks: %zu, hardware threads: %u\n", tracks, std::thread::hardware_concurrency());
+    std::printf("%8s %14s %9s %14s %9s %8s\n", "threads", "logged ms", "speed-up", "quiet ms", "speed-up",
+                "ordered");
+    const size_t thread_counts[] = {1, 2, 4, 8};
+    double base_logged = 0.0;
+    double base_quiet = 0.0;
+    for (size_t threads : thread_counts) {
+        bool logged_ordered = false;
+        bool quiet_ordered = false;
+        const double logged = build_once(infos, threads, true, logged_ordered);
+        const double quiet = build_once(infos, threads, false, quiet_ordered);
+        if (threads == 1) {
+            base_logged = logged;
+            base_quiet = quiet;
+        }
+        std::printf("%8zu %14.1f %8.2fx %14.1f %8.2fx %8s\n", threads, logged, base_logged / logged, quiet,
+                    base_quiet / quiet, logged_ordered && quiet_ordered ? "yes" : "NO");
+    }
+    return 0;
+}
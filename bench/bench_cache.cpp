@@ -0,0 +1,94 @@
+/**
+ * Controller cache scaling benchmark
+ *
+ * Measures LRUCache cost as capacity grows from 8 to 100k slots:
+ * - get_hit: random get() over a full cache (every lookup hits and is promoted to MRU)
+ * - put_evict: put() of fresh tracks into a full cache (every insert evicts the LRU entry),
+ *   mirroring a MISS in DJControllerService::loadTrackToCache
+ * Tracks are built before the timed region so only cache work is measured.
+ * With O(1) operations both ns/op columns should stay flat across capacities.
+ *
+ * Build and run:  make bench && ./bin/bench_cache
+ */
+#include "LRUCache.h"
+#include "AudioTrack.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Minimal concrete track: single-sample waveform so large caches stay cheap to fill
+class BenchTrack : public AudioTrack {
+public:
+    explicit BenchTrack(const std::string& title)
+        : AudioTrack(title, std::vector<std::string>(1, "Bench"), 300, 128, 1) {}
+    void load() override {}
+    void analyze_beatgrid() override {}
+    double get_quality_score() const override { return 0.0; }
+    TrackFormat get_format() const override { return TrackFormat::WAV; }
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new BenchTrack(*this));
+    }
+};
+
+double now_ns() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+int main() {
+    const size_t capacities[] = {8, 64, 512, 4096, 32768, 100000};
+    const size_t get_ops = 1000000;
+    const size_t put_ops = 200000;
+
+    std::printf("%10s %14s %14s\n", "capacity", "get_hit ns/op", "put_evict ns/op");
+    for (size_t capacity : capacities) {
+        LRUCache cache(capacity);
+        std::vector<std::string> keys;
+        keys.reserve(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            keys.push_back("library_track_" + std::to_string(i + 1));
+            cache.put(PointerWrapper<AudioTrack>(new BenchTrack(keys.back())));
+        }
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<size_t> pick(0, capacity - 1);
+        std::vector<size_t> trace(get_ops);
+        for (size_t i = 0; i < get_ops; ++i) trace[i] = pick(gen);
+
+        size_t hits = 0;
+        double start = now_ns();
+        for (size_t i = 0; i < get_ops; ++i) {
+            if (cache.get(keys[trace[i]])) ++hits;
+        }
+        double get_ns = (now_ns() - start) / get_ops;
+
+        std::vector<PointerWrapper<AudioTrack> > fresh;
+        fresh.reserve(put_ops);
+        for (size_t i = 0; i < put_ops; ++i) {
+            fresh.push_back(PointerWrapper<AudioTrack>(
+                new BenchTrack("fresh_track_" + std::to_string(i + 1))));
+        }
+
+        size_t evictions = 0;
+        start = now_ns();
+        for (size_t i = 0; i < put_ops; ++i) {
+            if (cache.put(std::move(fresh[i]))) ++evictions;
+        }
+        double put_ns = (now_ns() - start) / put_ops;
+
+        if (hits != get_ops || evictions != put_ops) {
+            std::fprintf(stderr, "unexpected result at capacity %zu: %zu hits, %zu evictions\n",
+                         capacity, hits, evictions);
+            return 1;
+        }
+        std::printf("%10zu %14.1f %14.1f\n", capacity, get_ns, put_ns);
+    }
+    return 0;
+}
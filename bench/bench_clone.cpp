@@ -0,0 +1,78 @@
+/**
+ * Track clone benchmark (copy-on-write waveforms)
+ *
+ * Clones tracks with the default 1000-sample waveform and with one second of
+ * 44.1 kHz samples, the way the library → cache → deck boundaries do, and
+ * reports per clone:
+ * - ns/op
+ * - waveform blocks and bytes allocated (from WaveformBuffer::stats())
+ * "clone" only reads the clone; "clone+edit" writes one sample in every clone,
+ * forcing the copy-on-write duplication a deep copy would always pay.
+ *
+ * Build and run:  make bench && ./bin/bench_clone
+ */
+#include "AudioTrack.h"
+#include "WaveformBuffer.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+class BenchTrack : public AudioTrack {
+public:
+    explicit BenchTrack(size_t samples)
+        : AudioTrack("Bench Track", std::vector<std::string>(1, "Bench"), 240, 128, samples) {}
+    void load() override {}
+    void analyze_beatgrid() override {}
+    double get_quality_score() const override { return 0.0; }
+    TrackFormat get_format() const override { return TrackFormat::WAV; }
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new BenchTrack(*this));
+    }
+};
+
+double now_ns() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void run(const char* label, const AudioTrack& source, bool write, size_t ops) {
+    std::vector<PointerWrapper<AudioTrack> > clones;
+    clones.reserve(ops);
+    const WaveformBuffer::Stats before = WaveformBuffer::stats();
+    double start = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        clones.push_back(source.clone());
+        if (write) {
+            const double silence = 0.0;
+            clones.back()->write_waveform(0, &silence, 1);
+        }
+    }
+    double ns = (now_ns() - start) / ops;
+    const WaveformBuffer::Stats after = WaveformBuffer::stats();
+    std::printf("%-22s %12.1f %16.3f %16.1f\n", label, ns,
+                static_cast<double>(after.allocations - before.allocations) / ops,
+                static_cast<double>(after.bytes_allocated - before.bytes_allocated) / ops);
+}
+
+} // namespace
+
+int main() {
+    const size_t ops = 20000;
+    BenchTrack short_track(1000);
+    BenchTrack long_track(44100);
+    // Materialise the (lazy) samples up front so clones share them
+    double first = 0.0;
+    short_track.get_waveform_copy(&first, 1);
+    long_track.get_waveform_copy(&first, 1);
+
+    std::printf("%-22s %12s %16s %16s\n", "case", "ns/clone", "wave allocs/op", "wave bytes/op");
+    run("1k samples clone", short_track, false, ops);
+    run("1k samples clone+edit", short_track, true, ops);
+    run("44k samples clone", long_track, false, ops / 10);
+    run("44k samples clone+edit", long_track, true, ops / 10);
+    return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * Concurrent controller cache benchmark
+ *
+ * Several threads (one per simulated booth) look tracks up in one shared
+ * cache and insert a clone on every miss, as DJControllerService does.
+ * Keys are skewed: 80% of accesses go to the hottest 20% of 4096 titles;
+ * the cache holds 1024. Three caches are compared at 1, 2, 4 and 8 threads:
+ * - global lock: an LRUCache behind one std::mutex (the only safe way to
+ *   share it before ShardedCache)
+ * - sharded x1: ShardedCache with a single shard (read-write lock, CLOCK)
+ * - sharded x64: ShardedCache with 64 shards
+ * Throughput is lookups per second over 200k lookups per thread. The
+ * contention report gives, for the 64-shard cache at the highest thread
+ * count, how many lock acquisitions had to wait and how evenly lookups
+ * spread over the shards.
+ *
+ * Build and run:  make bench && ./bin/bench_concurrent [max_threads]
+ */
+#include "LRUCache.h"
+#include "ShardedCache.h"
+#include "AudioTrack.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const size_t KEYS = 4096;
+const size_t CAPACITY = 1024;
+const size_t LOOKUPS_PER_THREAD = 200000;
+
+// Minimal concrete track: single-sample waveform, silent copies
+class BenchTrack : public AudioTrack {
+public:
+    explicit BenchTrack(const std::string& title)
+        : AudioTrack(title, std::vector<std::string>(1, "Bench"), 300, 128, 1) {}
+    void load() override {}
+    void analyze_beatgrid() override {}
+    double get_quality_score() const override { return 0.0; }
+    TrackFormat get_format() const override { return TrackFormat::WAV; }
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new BenchTrack(*this));
+    }
+};
+
+double now_s() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1e6;
+}
+
+// Access sequence of one thread: 80% hot (first 20% of keys), 20% cold
+std::vector<size_t> make_sequence(unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<size_t> hot(0, KEYS / 5 - 1);
+    std::uniform_int_distribution<size_t> any(0, KEYS - 1);
+    std::vector<size_t> sequence(LOOKUPS_PER_THREAD);
+    for (size_t& key : sequence) {
+        key = coin(rng) < 0.8 ? hot(rng) : any(rng);
+    }
+    return sequence;
+}
+
+struct Run {
+    double lookups_per_second;
+    double hit_rate;
+};
+
+// body(thread, key) performs one lookup (+ insert on miss) and returns true on a hit
+template <typename Body>
+Run run_threads(size_t threads, const std::vector<std::vector<size_t> >& sequences, Body body) {
+    std::vector<size_t> hits(threads, 0);
+    std::vector<std::thread> workers;
+    const double start = now_s();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&, t]() {
+            size_t local = 0;
+            for (size_t key : sequences[t]) {
+                local += body(key) ? 1 : 0;
+            }
+            hits[t] = local;
+        }));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    const double seconds = now_s() - start;
+    size_t total_hits = 0;
+    for (size_t h : hits) total_hits += h;
+    const double lookups = static_cast<double>(threads * LOOKUPS_PER_THREAD);
+    Run result = {lookups / seconds, static_cast<double>(total_hits) / lookups};
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t max_threads = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 8;
+    std::vector<BenchTrack*> library;
+    std::vector<std::string> titles;
+    for (size_t i = 0; i < KEYS; ++i) {
+        titles.push_back("Concurrent Track " + std::to_string(i));
+        library.push_back(new BenchTrack(titles.back()));
+    }
+    std::vector<std::vector<size_t> > sequences;
+    for (size_t t = 0; t < max_threads; ++t) {
+        sequences.push_back(make_sequence(static_cast<unsigned>(1234 + t)));
+    }
+
+    std::printf("hardware threads: %u, keys: %zu, capacity: %zu, lookups/thread: %zu\n",
+                std::thread::hardware_concurrency(), KEYS, CAPACITY, LOOKUPS_PER_THREAD);
+    std::printf("%7s  %22s  %22s  %22s\n", "threads", "global lock (M/s, hit)", "sharded x1 (M/s, hit)",
+                "sharded x64 (M/s, hit)");
+
+    std::unique_ptr<ShardedCache> last_sharded;
+    size_t last_threads = 0;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        LRUCache locked(CAPACITY);
+        std::mutex lock;
+        const Run global = run_threads(threads, sequences, [&](size_t key) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (locked.get(titles[key])) return true;
+            locked.put(library[key]->clone());
+            return false;
+        });
+
+        ShardedCache single(CAPACITY, 1);
+        const Run one = run_threads(threads, sequences, [&](size_t key) {
+            if (single.get(titles[key])) return true;
+            single.put(library[key]->clone());
+            return false;
+        });
+
+        std::unique_ptr<ShardedCache> sharded(new ShardedCache(CAPACITY, 64));
+        ShardedCache& cache = *sharded;
+        const Run many = run_threads(threads, sequences, [&](size_t key) {
+            if (cache.get(titles[key])) return true;
+            cache.put(library[key]->clone());
+            return false;
+        });
+
+        std::printf("%7zu  %14.2f  %5.1f%%  %14.2f  %5.1f%%  %14.2f  %5.1f%%\n", threads,
+                    global.lookups_per_second / 1e6, 100.0 * global.hit_rate, one.lookups_per_second / 1e6,
+                    100.0 * one.hit_rate, many.lookups_per_second / 1e6, 100.0 * many.hit_rate);
+        last_sharded = std::move(sharded);
+        last_threads = threads;
+    }
+
+    // Contention report for the last (largest) sharded run
+    const ShardedCache::Stats total = last_sharded->stats();
+    uint64_t busiest = 0;
+    uint64_t quietest = UINT64_MAX;
+    for (size_t s = 0; s < last_sharded->shard_count(); ++s) {
+        const ShardedCache::Stats shard = last_sharded->shard_stats(s);
+        busiest = std::max(busiest, shard.hits + shard.misses);
+        quietest = std::min(quietest, shard.hits + shard.misses);
+    }
+    const double mean = static_cast<double>(total.hits + total.misses) / last_sharded->shard_count();
+    std::printf("\ncontention, sharded x64 at %zu threads:\n", last_threads);
+    std::printf("  lock acquisitions: %llu, waited: %llu (%.3f%%)\n",
+                static_cast<unsigned long long>(total.lock_acquisitions),
+                static_cast<unsigned long long>(total.lock_contended),
+                100.0 * static_cast<double>(total.lock_contended) / static_cast<double>(total.lock_acquisitions));
+    std::printf("  lookups per shard: mean %.0f, busiest %llu (%.2fx), quietest %llu\n", mean,
+                static_cast<unsigned long long>(busiest), static_cast<double>(busiest) / mean,
+                static_cast<unsigned long long>(quietest));
+    std::printf("  inserts: %llu, evictions: %llu\n", static_cast<unsigned long long>(total.inserts),
+                static_cast<unsigned long long>(total.evictions));
+
+    for (BenchTrack* track : library) {
+        delete track;
+    }
+    return 0;
+}
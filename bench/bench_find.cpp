@@ -0,0 +1,177 @@
+/**
+ * Track lookup benchmark
+ *
+ * Builds a library and a playlist holding every library track, for 10k, 100k
+ * and 1M entries (1000 artists, every third track with a featured second
+ * artist, BPM 90-149), then times lookups by title:
+ * - DJLibraryService::findTrack (playlist title index, as DJSession calls it)
+ * - findLibraryTrack (library title index)
+ * - a front-to-back title scan of the playlist, i.e. what find_track used to
+ *   cost (measured over getTracks(), so it is a lower bound for the old list walk)
+ * Looked-up titles are spread uniformly over the playlist; the scan runs far
+ * fewer lookups, since each is O(n).
+ * The secondary indexes are then timed against the equivalent library scans:
+ * findTracksByArtist, and findTracksByBpm at 128 +/- 2 BPM.
+ *
+ * Build and run:  make bench && ./bin/bench_find
+ */
+#include "DJLibraryService.h"
+#include "SessionFileParser.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+std::vector<SessionConfig::TrackInfo> make_infos(size_t tracks) {
+    std::vector<SessionConfig::TrackInfo> infos(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        SessionConfig::TrackInfo& info = infos[i];
+        info.type = (i % 2 == 0) ? "MP3" : "WAV";
+        info.title = "Library Track " + std::to_string(i + 1);
+        info.artists.push_back("Artist " + std::to_string(i % 1000));
+        if (i % 3 == 0) {
+            info.artists.push_back("Featured " + std::to_string(i % 500));
+        }
+        info.duration_seconds = 180 + static_cast<int>(i % 240);
+        info.bpm = 90 + static_cast<int>(i % 60);
+        info.extra_param1 = (i % 2 == 0) ? 320 : 44100;
+        info.extra_param2 = (i % 2 == 0) ? 1 : 16;
+    }
+    return infos;
+}
+
+struct SecondaryTimes {
+    double artist_ns;
+    double artist_scan_ns;
+    double bpm_ns;
+    double bpm_scan_ns;
+    size_t matches;
+};
+
+SecondaryTimes time_secondary(const DJLibraryService& library, const std::vector<AudioTrack*>& all) {
+    SecondaryTimes times = {0.0, 0.0, 0.0, 0.0, 0};
+    const size_t queries = 1000;
+    const size_t scans = 20;
+
+    double start = now_ms();
+    for (size_t i = 0; i < queries; ++i) {
+        times.matches += library.findTracksByArtist("Featured " + std::to_string(i % 500)).size();
+    }
+    times.artist_ns = (now_ms() - start) * 1e6 / queries;
+
+    start = now_ms();
+    for (size_t i = 0; i < scans; ++i) {
+        const std::string artist = "Featured " + std::to_string(i % 500);
+        for (AudioTrack* track : all) {
+            for (const InternedString& name : track->get_artists()) {
+                if (name.str() == artist) {
+                    ++times.matches;
+                    break;
+                }
+            }
+        }
+    }
+    times.artist_scan_ns = (now_ms() - start) * 1e6 / scans;
+
+    start = now_ms();
+    for (size_t i = 0; i < queries; ++i) {
+        times.matches += library.findTracksByBpm(128, 2).size();
+    }
+    times.bpm_ns = (now_ms() - start) * 1e6 / queries;
+
+    start = now_ms();
+    for (size_t i = 0; i < scans; ++i) {
+        std::vector<AudioTrack*> matches;
+        for (AudioTrack* track : all) {
+            if (track->get_bpm() >= 126 && track->get_bpm() <= 130) {
+                matches.push_back(track);
+            }
+        }
+        times.matches += matches.size();
+    }
+    times.bpm_scan_ns = (now_ms() - start) * 1e6 / scans;
+    return times;
+}
+
+SecondaryTimes run(size_t tracks) {
+    // Library and playlist logging is dropped (null buffer) so only the work is timed
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    DJLibraryService library;
+    library.buildLibrary(make_infos(tracks));
+    std::vector<int> indices(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        indices[i] = static_cast<int>(i + 1);
+    }
+    library.loadPlaylistFromIndices("bench", indices);
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<size_t> pick(1, tracks);
+    const size_t lookups = 1000000;
+    std::vector<std::string> titles(lookups);
+    for (std::string& title : titles) {
+        title = "Library Track " + std::to_string(pick(gen));
+    }
+
+    size_t found = 0;
+    double start = now_ms();
+    for (const std::string& title : titles) {
+        found += library.findTrack(title) != nullptr;
+    }
+    const double index_ns = (now_ms() - start) * 1e6 / lookups;
+
+    start = now_ms();
+    for (const std::string& title : titles) {
+        found += library.findLibraryTrack(title) != nullptr;
+    }
+    const double library_ns = (now_ms() - start) * 1e6 / lookups;
+
+    const std::vector<AudioTrack*> list = library.getPlaylist().getTracks();
+    const size_t scans = 200;
+    start = now_ms();
+    for (size_t i = 0; i < scans; ++i) {
+        for (AudioTrack* track : list) {
+            if (track->get_title() == titles[i]) {
+                ++found;
+                break;
+            }
+        }
+    }
+    const double scan_ns = (now_ms() - start) * 1e6 / scans;
+
+    std::printf("%9zu %14.0f %14.0f %14.0f %10.0fx   (found %zu)\n",
+                tracks, index_ns, library_ns, scan_ns, scan_ns / index_ns, found);
+    return time_secondary(library, list);
+}
+
+} // namespace
+
+int main() {
+    std::printf("%9s %14s %14s %14s %11s\n", "entries", "findTrack ns", "library ns", "scan ns",
+                "speedup");
+    const size_t sizes[] = {10000, 100000, 1000000};
+    std::vector<SecondaryTimes> secondary;
+    for (size_t tracks : sizes) {
+        secondary.push_back(run(tracks));
+    }
+
+    std::printf("\n%9s %14s %14s %14s %14s\n", "entries", "artist ns", "artist scan", "bpm+/-2 ns",
+                "bpm scan");
+    for (size_t i = 0; i < secondary.size(); ++i) {
+        const SecondaryTimes& t = secondary[i];
+        std::printf("%9zu %14.0f %14.0f %14.0f %14.0f   (matches %zu)\n", sizes[i], t.artist_ns,
+                    t.artist_scan_ns, t.bpm_ns, t.bpm_scan_ns, t.matches);
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * Track id benchmark
+ *
+ * Times one play_all track step (library lookup, controller cache load, cache
+ * fetch for the deck: what DJSession does per track, minus the deck clone)
+ * keyed by title and keyed by library id, on a warm cache that holds the
+ * whole playlist, so every load is a HIT and only the keying differs:
+ * - title: findTrack(title), loadTrackToCache, getTrackFromCache(title)
+ * - id:    getTrack(id), loadTrackToCache, getTrackFromCache(id)
+ * Below that, the cache lookup alone: LRUCache::get by title (intern pool
+ * lookup, then the index) and by interned title (index only).
+ * Playlists of 64, 1024 and 16384 tracks; steps pick tracks uniformly.
+ * Controller logging goes to a null buffer, so formatting is not timed.
+ *
+ * Build and run:  make bench && ./bin/bench_ids
+ */
+#include "DJControllerService.h"
+#include "DJLibraryService.h"
+#include "LRUCache.h"
+#include "SessionFileParser.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t STEPS = 1000000;
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+std::vector<SessionConfig::TrackInfo> make_infos(size_t tracks) {
+    std::vector<SessionConfig::TrackInfo> infos(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        SessionConfig::TrackInfo& info = infos[i];
+        info.type = (i % 2 == 0) ? "MP3" : "WAV";
+        info.title = "Library Track " + std::to_string(i + 1);
+        info.artists.push_back("Artist " + std::to_string(i % 100));
+        info.duration_seconds = 180 + static_cast<int>(i % 240);
+        info.bpm = 90 + static_cast<int>(i % 60);
+        info.extra_param1 = (i % 2 == 0) ? 320 : 44100;
+        info.extra_param2 = (i % 2 == 0) ? 1 : 16;
+    }
+    return infos;
+}
+
+void run(size_t tracks) {
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    DJLibraryService library;
+    library.buildLibrary(make_infos(tracks));
+    std::vector<int> indices(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        indices[i] = static_cast<int>(i + 1);
+    }
+    library.loadPlaylistFromIndices("bench", indices);
+    const std::vector<std::string> titles = library.getTrackTitles();
+    const std::vector<TrackId> ids = library.getTrackIds();
+
+    DJControllerService controller(tracks);
+    for (TrackId id : ids) {
+        controller.loadTrackToCache(*library.getTrack(id));
+    }
+
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<size_t> pick(0, tracks - 1);
+    std::vector<size_t> steps(STEPS);
+    for (size_t& step : steps) {
+        step = pick(gen);
+    }
+
+    size_t served = 0;
+    double start = now_ms();
+    for (size_t step : steps) {
+        const std::string& title = titles[step];
+        controller.loadTrackToCache(*library.findTrack(title));
+        served += controller.getTrackFromCache(title) != nullptr;
+    }
+    const double title_ns = (now_ms() - start) * 1e6 / STEPS;
+
+    start = now_ms();
+    for (size_t step : steps) {
+        const TrackId id = ids[step];
+        controller.loadTrackToCache(*library.getTrack(id));
+        served += controller.getTrackFromCache(id) != nullptr;
+    }
+    const double id_ns = (now_ms() - start) * 1e6 / STEPS;
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+
+    // The cache lookup alone, on a bare LRUCache holding library clones
+    LRUCache cache(tracks);
+    std::vector<InternedString> keys;
+    keys.reserve(tracks);
+    for (TrackId id : ids) {
+        AudioTrack* track = library.getTrack(id);
+        cache.put(track->clone());
+        keys.push_back(track->get_title_id());
+    }
+    start = now_ms();
+    for (size_t step : steps) {
+        served += cache.get(titles[step]) != nullptr;
+    }
+    const double get_title_ns = (now_ms() - start) * 1e6 / STEPS;
+
+    start = now_ms();
+    for (size_t step : steps) {
+        served += cache.get(keys[step]) != nullptr;
+    }
+    const double get_id_ns = (now_ms() - start) * 1e6 / STEPS;
+
+    std::printf("%9zu %12.1f %12.1f %8.2fx %12.1f %12.1f %8.2fx   (served %zu)\n", tracks, title_ns,
+                id_ns, title_ns / id_ns, get_title_ns, get_id_ns, get_title_ns / get_id_ns, served);
+}
+
+} // namespace
+
+int main() {
+    std::printf("%9s %12s %12s %9s %12s %12s %9s\n", "tracks", "step title", "step id", "speedup",
+                "get title", "get id", "speedup");
+    const size_t sizes[] = {64, 1024, 16384};
+    for (size_t tracks : sizes) {
+        run(tracks);
+    }
+    return 0;
+}
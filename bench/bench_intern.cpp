@@ -0,0 +1,112 @@
+/**
+ * String interning memory benchmark
+ *
+ * Builds a library from the sample config (input_2/dj_config.txt, or the
+ * path given) and from a generated 1M-track config (1000 artists, every
+ * third track with a featured artist), clones every track once (as
+ * playlists and the cache do), and compares the bytes spent on titles and
+ * artists:
+ * - per-copy strings, as AudioTrack stored them before interning: a
+ *   std::string title and a std::vector<std::string> of artists per copy
+ *   (heap buffers counted for strings past the small-string limit)
+ * - interned: a 4-byte title id and a vector of 4-byte artist ids per copy,
+ *   plus the pool's growth (InternedString::pool_stats()), paid once
+ *
+ * Build and run:  make bench && ./bin/bench_intern [config]
+ */
+#include "DJLibraryService.h"
+#include "InternedString.h"
+#include "SessionFileParser.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+size_t string_heap(const std::string& value) {
+    return value.capacity() > std::string().capacity() ? value.capacity() + 1 : 0;
+}
+
+struct Footprint {
+    size_t copies = 0;
+    size_t per_copy_strings = 0;
+    size_t interned_ids = 0;
+};
+
+void add_copy(Footprint& footprint, const AudioTrack& track) {
+    footprint.copies++;
+    footprint.per_copy_strings += sizeof(std::string) + string_heap(track.get_title()) +
+                                  sizeof(std::vector<std::string>) +
+                                  track.get_artists().size() * sizeof(std::string);
+    for (const InternedString& artist : track.get_artists()) {
+        footprint.per_copy_strings += string_heap(artist.str());
+    }
+    footprint.interned_ids += sizeof(InternedString) + sizeof(std::vector<InternedString>) +
+                              track.get_artists().capacity() * sizeof(InternedString);
+}
+
+void report(const char* label, const std::vector<SessionConfig::TrackInfo>& infos) {
+    const size_t pool_before = InternedString::pool_stats().bytes;
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    size_t pool_bytes = 0;
+    Footprint footprint;
+    {
+        DJLibraryService library;
+        library.buildLibrary(infos);
+        pool_bytes = InternedString::pool_stats().bytes - pool_before;
+        std::vector<PointerWrapper<AudioTrack> > clones;
+        clones.reserve(infos.size());
+        for (const auto& info : infos) {
+            AudioTrack* track = library.findLibraryTrack(info.title);
+            if (!track) continue;
+            add_copy(footprint, *track);
+            clones.push_back(track->clone());
+            add_copy(footprint, *clones.back());
+        }
+    }
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+
+    const size_t interned = footprint.interned_ids + pool_bytes;
+    std::printf("%-22s %9zu %14zu %14zu %12zu %14zu %7.1f%%\n", label, footprint.copies,
+                footprint.per_copy_strings, footprint.interned_ids, pool_bytes, interned,
+                100.0 * (1.0 - static_cast<double>(interned) / footprint.per_copy_strings));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string config_path = argc > 1 ? argv[1] : "input_2/dj_config.txt";
+    std::printf("%-22s %9s %14s %14s %12s %14s %8s\n", "library", "copies", "strings B", "ids B", "pool B",
+                "interned B", "saved");
+
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    SessionConfig sample;
+    const bool parsed = SessionFileParser::parse_config_file(config_path, sample);
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+    if (parsed) {
+        report(config_path.c_str(), sample.library_tracks);
+    } else {
+        std::printf("%-22s (cannot read)\n", config_path.c_str());
+    }
+
+    const size_t tracks = 1000000;
+    std::vector<SessionConfig::TrackInfo> infos(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        SessionConfig::TrackInfo& info = infos[i];
+        info.type = (i % 2 == 0) ? "MP3" : "WAV";
+        info.title = "Library Track " + std::to_string(i + 1);
+        info.artists.push_back("Artist " + std::to_string(i % 1000));
+        if (i % 3 == 0) {
+            info.artists.push_back("Featured Artist " + std::to_string(i % 500));
+        }
+        info.duration_seconds = 180 + static_cast<int>(i % 240);
+        info.bpm = 90 + static_cast<int>(i % 60);
+        info.extra_param1 = (i % 2 == 0) ? 320 : 44100;
+        info.extra_param2 = (i % 2 == 0) ? 1 : 16;
+    }
+    report("generated 1M tracks", infos);
+    return 0;
+}
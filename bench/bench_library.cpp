@@ -0,0 +1,100 @@
+/**
+ * Library startup benchmark
+ *
+ * Times DJLibraryService::buildLibrary over a synthetic config of N tracks
+ * (default 1M, alternating MP3/WAV) and compares it with the per-track work
+ * the constructor used to do eagerly: a std::random_device, a freshly seeded
+ * std::mt19937 and 1000 uniform samples. The eager column is measured into a
+ * reused scratch buffer, so it counts CPU time only; holding the samples would
+ * also cost N * 8000 bytes.
+ * Finally, waveforms of a 10k-track playlist are materialised to show what a
+ * track pays on first access instead.
+ *
+ * Build and run:  make bench && ./bin/bench_library [tracks]
+ */
+#include "DJLibraryService.h"
+#include "SessionFileParser.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t tracks = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+    const size_t samples = 1000;
+
+    std::vector<SessionConfig::TrackInfo> infos(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        SessionConfig::TrackInfo& info = infos[i];
+        info.type = (i % 2 == 0) ? "MP3" : "WAV";
+        info.title = "Library Track " + std::to_string(i + 1);
+        info.artists.push_back("Artist " + std::to_string(i % 1000));
+        info.duration_seconds = 180 + static_cast<int>(i % 240);
+        info.bpm = 90 + static_cast<int>(i % 60);
+        info.extra_param1 = (i % 2 == 0) ? 320 : 44100;
+        info.extra_param2 = (i % 2 == 0) ? 1 : 16;
+    }
+
+    // Library and playlist logging is discarded so only the work is timed
+    std::ostringstream discard;
+    std::streambuf* saved = std::cout.rdbuf(discard.rdbuf());
+    DJLibraryService library;
+    double start = now_ms();
+    library.buildLibrary(infos);
+    double build_ms = now_ms() - start;
+    std::cout.rdbuf(saved);
+
+    std::vector<double> scratch(samples);
+    start = now_ms();
+    for (size_t i = 0; i < tracks; ++i) {
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        std::uniform_real_distribution<double> dis(-1.0, 1.0);
+        for (size_t s = 0; s < samples; ++s) {
+            scratch[s] = dis(gen);
+        }
+    }
+    double eager_ms = now_ms() - start;
+
+    // Clones of unmaterialised tracks stay unmaterialised until first access
+    const size_t touched = tracks < 10000 ? tracks : 10000;
+    std::vector<int> indices;
+    for (size_t i = 0; i < touched; ++i) {
+        indices.push_back(static_cast<int>(i + 1));
+    }
+    saved = std::cout.rdbuf(discard.rdbuf());
+    library.loadPlaylistFromIndices("bench", indices);
+    std::cout.rdbuf(saved);
+    std::vector<AudioTrack*> playlist_tracks = library.getPlaylist().getTracks();
+
+    double checksum = 0.0;
+    start = now_ms();
+    for (AudioTrack* track : playlist_tracks) {
+        double first = 0.0;
+        track->get_waveform_copy(&first, 1);
+        checksum += first;
+    }
+    double touch_ms = now_ms() - start;
+
+    std::printf("tracks: %zu\n", tracks);
+    std::printf("buildLibrary (lazy waveforms):          %10.1f ms\n", build_ms);
+    std::printf("eager waveform generation alone:        %10.1f ms (+%zu MB held)\n",
+                eager_ms, tracks * samples * sizeof(double) >> 20);
+    std::printf("materialise %6zu waveforms on demand:  %10.1f ms (checksum %.3f)\n",
+                touched, touch_ms, checksum);
+    return 0;
+}
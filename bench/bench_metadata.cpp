@@ -0,0 +1,123 @@
+/**
+ * Columnar metadata benchmark
+ *
+ * Builds a 1M-track library (or N, first argument) and a playlist holding a
+ * clone of every track, then times library-wide scans three ways:
+ * - walking the Playlist's PlaylistNode list (get_total_duration)
+ * - walking AudioTrack pointers (getTracks(), one object per row)
+ * - scanning TrackMetadataTable columns
+ * for total duration, the count of tracks within 120-130 BPM, and the total
+ * duration of MP3 tracks. Each scan runs 20 times; the best run is reported.
+ *
+ * Build and run:  make bench && ./bin/bench_metadata [tracks]
+ */
+#include "DJLibraryService.h"
+#include "MP3Track.h"
+#include "SessionFileParser.h"
+#include "TrackMetadataTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+// Best of 20 runs, in ms; result receives the scan's value
+double best_of(const std::function<int64_t()>& scan, int64_t& result) {
+    double best = 1e300;
+    for (int run = 0; run < 20; ++run) {
+        const double start = now_ms();
+        result = scan();
+        best = std::min(best, now_ms() - start);
+    }
+    return best;
+}
+
+void row(const char* label, double pointer_ms, int64_t pointer_value, double column_ms, int64_t column_value) {
+    std::printf("%-26s %12.3f %12.3f %9.1fx   %s\n", label, pointer_ms, column_ms, pointer_ms / column_ms,
+                pointer_value == column_value ? "same result" : "MISMATCH");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t tracks = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+    std::vector<SessionConfig::TrackInfo> infos(tracks);
+    std::vector<int> indices(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        SessionConfig::TrackInfo& info = infos[i];
+        info.type = (i % 2 == 0) ? "MP3" : "WAV";
+        info.title = "Library Track " + std::to_string(i + 1);
+        info.artists.push_back("Artist " + std::to_string(i % 1000));
+        info.duration_seconds = 180 + static_cast<int>((i * 7919) % 240);
+        info.bpm = 90 + static_cast<int>((i * 104729) % 60);
+        info.extra_param1 = (i % 2 == 0) ? 320 : 44100;
+        info.extra_param2 = (i % 2 == 0) ? 1 : 16;
+        indices[i] = static_cast<int>(i + 1);
+    }
+
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    DJLibraryService library;
+    library.buildLibrary(infos);
+    library.loadPlaylistFromIndices("bench", indices);
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+
+    const Playlist& playlist = library.getPlaylist();
+    const std::vector<AudioTrack*> objects = playlist.getTracks();
+    const TrackMetadataTable& table = library.getMetadata();
+    std::printf("tracks: %zu (table rows: %zu)\n", tracks, table.size());
+    std::printf("%-26s %12s %12s %10s\n", "scan", "pointer ms", "column ms", "speed-up");
+
+    int64_t list_total = 0;
+    int64_t column_total = 0;
+    const double list_ms = best_of([&]() { return static_cast<int64_t>(playlist.get_total_duration()); },
+                                   list_total);
+    const double column_ms = best_of([&]() { return table.total_duration(); }, column_total);
+    row("total duration (list)", list_ms, list_total, column_ms, column_total);
+
+    int64_t object_total = 0;
+    const double object_ms = best_of([&]() {
+        int64_t total = 0;
+        for (const AudioTrack* track : objects) total += track->get_duration();
+        return total;
+    }, object_total);
+    row("total duration (objects)", object_ms, object_total, column_ms, column_total);
+
+    int64_t object_count = 0;
+    int64_t column_count = 0;
+    const double object_count_ms = best_of([&]() {
+        int64_t count = 0;
+        for (const AudioTrack* track : objects) count += track->get_bpm() >= 120 && track->get_bpm() <= 130;
+        return count;
+    }, object_count);
+    const double column_count_ms = best_of([&]() {
+        return static_cast<int64_t>(table.count_bpm_range(120, 130));
+    }, column_count);
+    row("count 120-130 BPM", object_count_ms, object_count, column_count_ms, column_count);
+
+    int64_t object_mp3 = 0;
+    int64_t column_mp3 = 0;
+    const double object_mp3_ms = best_of([&]() {
+        int64_t total = 0;
+        for (const AudioTrack* track : objects) {
+            if (dynamic_cast<const MP3Track*>(track)) {
+                total += track->get_duration();
+            }
+        }
+        return total;
+    }, object_mp3);
+    const double column_mp3_ms = best_of([&]() { return table.total_duration(TrackFormat::MP3); }, column_mp3);
+    row("MP3 duration (dyn. cast)", object_mp3_ms, object_mp3, column_mp3_ms, column_mp3);
+    return 0;
+}
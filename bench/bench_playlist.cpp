@@ -0,0 +1,259 @@
+/**
+ * Playlist storage benchmark
+ *
+ * Compares the pooled, doubly-linked Playlist with the singly-linked list it
+ * replaced (one heap node per track, prepend only, rebuilt here as
+ * LegacyList) at N entries (default 1M, first argument):
+ * - build: construct each track and insert it, the way loadPlaylistFromIndices
+ *   interleaves clones and inserts; then inserts alone, of pre-built tracks
+ * - traversal: a node-only walk, a walk summing durations, and getTracks()
+ *   (copy into a vector, then walk) against iterating in place; best of 10
+ * - statistics poll: total duration, BPM range and mean, MP3 count and Studio
+ *   tier count, by walking the list against the running PlaylistStats
+ * - removal: 100 tracks from the middle, by handle against the old
+ *   walk-to-predecessor
+ *
+ * Build and run:  make bench && ./bin/bench_playlist [entries]
+ */
+#include "MP3Track.h"
+#include "Playlist.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+// The storage Playlist used before: one heap node per track, prepend only,
+// plus the same title index, so both sides pay for it
+struct LegacyNode {
+    AudioTrack* track;
+    LegacyNode* next;
+};
+
+class LegacyList {
+private:
+    LegacyNode* head;
+    std::unordered_map<std::string, std::pair<LegacyNode*, size_t>> title_index;
+
+public:
+    LegacyList() : head(nullptr), title_index() {}
+    ~LegacyList() {
+        while (head) {
+            LegacyNode* next = head->next;
+            delete head->track;
+            delete head;
+            head = next;
+        }
+    }
+    LegacyList(const LegacyList&) = delete;
+    LegacyList& operator=(const LegacyList&) = delete;
+
+    LegacyNode* get_head() const { return head; }
+
+    LegacyNode* add_track(AudioTrack* track) {
+        head = new LegacyNode{track, head};
+        auto inserted = title_index.emplace(track->get_title(), std::make_pair(head, static_cast<size_t>(1)));
+        if (!inserted.second) {
+            inserted.first->second.first = head;
+            inserted.first->second.second++;
+        }
+        return head;
+    }
+
+    // Walk from the head to find node's predecessor, as remove_track did
+    void remove(LegacyNode* node) {
+        LegacyNode* prev = nullptr;
+        LegacyNode* current = head;
+        while (current != node) {
+            prev = current;
+            current = current->next;
+        }
+        (prev ? prev->next : head) = node->next;
+        title_index.erase(node->track->get_title());
+        delete node->track;
+        delete node;
+    }
+};
+
+AudioTrack* make_track(size_t i) {
+    return new MP3Track("Playlist Track " + std::to_string(i), {"Artist " + std::to_string(i % 1000)},
+                        180 + static_cast<int>(i % 240), 90 + static_cast<int>(i % 60), 320);
+}
+
+double best_of(const std::function<long long()>& walk, long long& result) {
+    double best = 1e300;
+    for (int run = 0; run < 10; ++run) {
+        const double start = now_ms();
+        result = walk();
+        best = std::min(best, now_ms() - start);
+    }
+    return best;
+}
+
+void row(const char* label, double legacy_ms, double pooled_ms) {
+    std::printf("%-34s %11.2f %11.2f %8.1fx\n", label, legacy_ms, pooled_ms, legacy_ms / pooled_ms);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t entries = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+    const size_t removals = std::min<size_t>(100, entries / 2);
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+
+    // Build, interleaving track construction with inserts
+    LegacyList legacy;
+    double start = now_ms();
+    for (size_t i = 0; i < entries; ++i) {
+        legacy.add_track(make_track(i));
+    }
+    const double legacy_build_ms = now_ms() - start;
+
+    Playlist pooled("bench");
+    std::vector<PlaylistNode*> handles(entries);
+    start = now_ms();
+    for (size_t i = 0; i < entries; ++i) {
+        handles[i] = pooled.append_track(make_track(i));
+    }
+    const double pooled_build_ms = now_ms() - start;
+
+    // Inserts alone
+    std::vector<AudioTrack*> spare(entries);
+    for (size_t i = 0; i < entries; ++i) {
+        spare[i] = make_track(i);
+    }
+    double legacy_insert_ms = 0;
+    double pooled_insert_ms = 0;
+    {
+        LegacyList list;
+        start = now_ms();
+        for (AudioTrack* track : spare) {
+            list.add_track(track->clone().release());
+        }
+        legacy_insert_ms = now_ms() - start;
+        Playlist playlist("insert");
+        start = now_ms();
+        for (AudioTrack* track : spare) {
+            playlist.append_track(track->clone().release());
+        }
+        pooled_insert_ms = now_ms() - start;
+    }
+    for (AudioTrack* track : spare) {
+        delete track;
+    }
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+
+    std::printf("entries: %zu\n", entries);
+    std::printf("%-34s %11s %11s %9s\n", "", "legacy ms", "pooled ms", "speed-up");
+    row("build (construct + insert)", legacy_build_ms, pooled_build_ms);
+    row("clone + insert", legacy_insert_ms, pooled_insert_ms);
+
+    long long legacy_value = 0;
+    long long pooled_value = 0;
+    const double legacy_nodes_ms = best_of([&]() {
+        long long count = 0;
+        for (LegacyNode* node = legacy.get_head(); node; node = node->next) count += node->track != nullptr;
+        return count;
+    }, legacy_value);
+    const double pooled_nodes_ms = best_of([&]() {
+        long long count = 0;
+        for (AudioTrack* track : pooled) count += track != nullptr;
+        return count;
+    }, pooled_value);
+    row("walk nodes", legacy_nodes_ms, pooled_nodes_ms);
+
+    const double legacy_sum_ms = best_of([&]() {
+        long long total = 0;
+        for (LegacyNode* node = legacy.get_head(); node; node = node->next) total += node->track->get_duration();
+        return total;
+    }, legacy_value);
+    const double pooled_sum_ms = best_of([&]() {
+        long long total = 0;
+        for (AudioTrack* track : pooled) total += track->get_duration();
+        return total;
+    }, pooled_value);
+    row("walk, summing durations", legacy_sum_ms, pooled_sum_ms);
+    if (legacy_value != pooled_value) {
+        std::printf("MISMATCH: %lld vs %lld\n", legacy_value, pooled_value);
+    }
+
+    const double copy_ms = best_of([&]() {
+        long long total = 0;
+        for (AudioTrack* track : pooled.getTracks()) total += track->get_duration();
+        return total;
+    }, legacy_value);
+    row("getTracks() copy vs iterate", copy_ms, pooled_sum_ms);
+
+    const double legacy_poll_ms = best_of([&]() {
+        long long total = 0, bpm_sum = 0, count = 0, mp3 = 0, studio = 0;
+        int min_bpm = 0, max_bpm = 0;
+        for (LegacyNode* node = legacy.get_head(); node; node = node->next) {
+            const AudioTrack* track = node->track;
+            total += track->get_duration();
+            bpm_sum += track->get_bpm();
+            min_bpm = count == 0 ? track->get_bpm() : std::min(min_bpm, track->get_bpm());
+            max_bpm = count == 0 ? track->get_bpm() : std::max(max_bpm, track->get_bpm());
+            mp3 += track->get_format() == TrackFormat::MP3;
+            studio += track->get_quality_tier() == QualityTier::Studio;
+            ++count;
+        }
+        return total + min_bpm + max_bpm + bpm_sum / std::max(count, 1LL) + mp3 + studio;
+    }, legacy_value);
+    const double pooled_poll_ms = best_of([&]() {
+        const PlaylistStats& stats = pooled.get_stats();
+        return stats.get_total_duration() + stats.get_min_bpm() + stats.get_max_bpm() +
+               static_cast<long long>(stats.get_mean_bpm()) +
+               static_cast<long long>(stats.get_format_count(TrackFormat::MP3)) +
+               static_cast<long long>(stats.get_tier_count(QualityTier::Studio));
+    }, pooled_value);
+    // One poll is too quick to time alone: time a million and report one
+    const PlaylistStats& stats = pooled.get_stats();
+    volatile long long sink = 0;
+    start = now_ms();
+    for (int poll = 0; poll < 1000000; ++poll) {
+        sink = sink + stats.get_total_duration() + stats.get_min_bpm() + stats.get_max_bpm();
+    }
+    const double poll_ns = (now_ms() - start) * 1e6 / 1000000;
+    std::printf("%-34s %11.2f %8.1f ns (best single poll %.4f ms)\n", "statistics poll", legacy_poll_ms,
+                poll_ns, pooled_poll_ms);
+    if (legacy_value != pooled_value) {
+        std::printf("MISMATCH: %lld vs %lld\n", legacy_value, pooled_value);
+    }
+
+    // Removal from the middle: every other node around entries / 2
+    std::vector<LegacyNode*> legacy_handles;
+    for (LegacyNode* node = legacy.get_head(); node; node = node->next) legacy_handles.push_back(node);
+    saved = std::cout.rdbuf(nullptr);
+    const size_t middle = entries / 2 - removals;
+    start = now_ms();
+    for (size_t i = 0; i < removals; ++i) {
+        legacy.remove(legacy_handles[middle + 2 * i]);
+    }
+    const double legacy_remove_ms = now_ms() - start;
+    start = now_ms();
+    for (size_t i = 0; i < removals; ++i) {
+        pooled.remove_track(handles[middle + 2 * i]);
+    }
+    const double pooled_remove_ms = now_ms() - start;
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+    char label[64];
+    std::snprintf(label, sizeof(label), "remove %zu from the middle", removals);
+    row(label, legacy_remove_ms, pooled_remove_ms);
+    std::printf("playlist tracks after removal: %d\n", pooled.get_track_count());
+    return 0;
+}
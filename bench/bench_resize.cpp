@@ -0,0 +1,164 @@
+/**
+ * Controller cache resize benchmark
+ *
+ * 1. Grow: a full cache grows one slot at a time (then the new slot is
+ *    filled), from 1k to 64k slots. In-place growth with geometric
+ *    reallocation should cost O(1) amortized per slot, flat across sizes.
+ *    For scale, the rebuild column times one rebuild of the whole cache (the
+ *    path set_capacity used for non-empty caches before; set_policy still
+ *    takes it), which is what each grow-by-one used to cost.
+ * 2. Shrink: halving a full cache, per evicted entry (eviction in policy
+ *    order plus compaction of the survivors).
+ * 3. Adaptive: DJControllerService replays three phases of demand loads with
+ *    working sets of 6, 40 and 12 tracks. Fixed 8- and 48-slot caches are
+ *    compared with adaptive sizing that starts at 8 slots under a ceiling
+ *    of 48 tracks' memory, and with a fixed cache of the adaptive run's mean
+ *    size: hit rate, and mean slots over the run.
+ *
+ * Build and run:  make bench && ./bin/bench_resize
+ */
+#include "DJControllerService.h"
+#include "LRUCache.h"
+#include "AudioTrack.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Minimal concrete track: single-sample waveform so large caches stay cheap to fill
+class BenchTrack : public AudioTrack {
+public:
+    explicit BenchTrack(const std::string& title)
+        : AudioTrack(title, std::vector<std::string>(1, "Bench"), 300, 128, 1) {}
+    void load() override {}
+    void analyze_beatgrid() override {}
+    double get_quality_score() const override { return 0.0; }
+    TrackFormat get_format() const override { return TrackFormat::WAV; }
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new BenchTrack(*this));
+    }
+};
+
+double now_ns() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void fill(LRUCache& cache, size_t from, size_t count) {
+    for (size_t i = from; i < from + count; ++i) {
+        cache.put(PointerWrapper<AudioTrack>(new BenchTrack("Resize Track " + std::to_string(i))));
+    }
+}
+
+void bench_grow_shrink() {
+    std::printf("%8s  %16s  %16s  %18s\n", "slots", "grow ns/slot", "rebuild us", "shrink ns/evicted");
+    const size_t sizes[] = {1024, 4096, 16384, 65536};
+    for (size_t target : sizes) {
+        LRUCache cache(target / 2);
+        fill(cache, 0, target / 2);
+        // Tracks for the new slots are built outside the timed region
+        std::vector<PointerWrapper<AudioTrack> > incoming;
+        for (size_t i = target / 2; i < target; ++i) {
+            incoming.push_back(PointerWrapper<AudioTrack>(new BenchTrack("Resize Track " + std::to_string(i))));
+        }
+        double grow_ns = 0.0;
+        for (size_t i = 0; i < incoming.size(); ++i) {
+            const double start = now_ns();
+            cache.set_capacity(cache.capacity() + 1);
+            grow_ns += now_ns() - start;
+            cache.put(std::move(incoming[i]));
+        }
+
+        double start = now_ns();
+        cache.set_policy(EvictionPolicy::create("lru"));
+        const double rebuild_ns = now_ns() - start;
+
+        start = now_ns();
+        const std::vector<std::string> evicted = cache.set_capacity(target / 2);
+        const double shrink_ns = now_ns() - start;
+
+        std::printf("%8zu  %16.1f  %16.1f  %18.1f\n", target, grow_ns / static_cast<double>(target / 2),
+                    rebuild_ns / 1e3, shrink_ns / static_cast<double>(evicted.size()));
+    }
+}
+
+struct Replay {
+    double hit_rate;
+    double mean_slots;
+};
+
+Replay replay(DJControllerService& controller, const std::vector<BenchTrack*>& library,
+              const std::vector<size_t>& stream) {
+    size_t hits = 0;
+    double slots = 0.0;
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    for (size_t track : stream) {
+        hits += controller.loadTrackToCache(*library[track]) == 1 ? 1 : 0;
+        slots += static_cast<double>(controller.get_cache_capacity());
+    }
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+    Replay result = {static_cast<double>(hits) / stream.size(), slots / stream.size()};
+    return result;
+}
+
+void bench_adaptive() {
+    std::vector<BenchTrack*> library;
+    for (size_t i = 0; i < 64; ++i) {
+        library.push_back(new BenchTrack("Adaptive Track " + std::to_string(i)));
+    }
+    // Three phases with different working sets, uniformly random within each
+    std::mt19937 rng(99);
+    std::vector<size_t> stream;
+    const size_t working_sets[] = {6, 40, 12};
+    for (size_t phase = 0; phase < 3; ++phase) {
+        std::uniform_int_distribution<size_t> pick(0, working_sets[phase] - 1);
+        for (size_t i = 0; i < 3000; ++i) {
+            stream.push_back(pick(rng) + 8 * phase);
+        }
+    }
+    const size_t per_track = library[0]->memory_footprint();
+
+    std::printf("\n%-22s  %8s  %10s\n", "controller cache", "hit rate", "mean slots");
+    {
+        DJControllerService fixed(8);
+        const Replay run = replay(fixed, library, stream);
+        std::printf("%-22s  %7.1f%%  %10.1f\n", "fixed 8 slots", 100.0 * run.hit_rate, run.mean_slots);
+    }
+    {
+        DJControllerService fixed(48);
+        const Replay run = replay(fixed, library, stream);
+        std::printf("%-22s  %7.1f%%  %10.1f\n", "fixed 48 slots", 100.0 * run.hit_rate, run.mean_slots);
+    }
+    {
+        DJControllerService adaptive(8);
+        adaptive.set_adaptive_sizing(48 * per_track);
+        const Replay run = replay(adaptive, library, stream);
+        const DJControllerService::ResizeStats& resizes = adaptive.get_resize_stats();
+        std::printf("%-22s  %7.1f%%  %10.1f  (%zu grown, %zu shrunk)\n", "adaptive, ceiling 48", 100.0 * run.hit_rate,
+                    run.mean_slots, resizes.grown, resizes.shrunk);
+
+        // A fixed cache with the same average memory
+        const size_t same = static_cast<size_t>(run.mean_slots + 0.5);
+        DJControllerService fixed(same);
+        const Replay matched = replay(fixed, library, stream);
+        std::printf("%-22s  %7.1f%%  %10.1f\n", ("fixed " + std::to_string(same) + " slots").c_str(),
+                    100.0 * matched.hit_rate, matched.mean_slots);
+    }
+    for (BenchTrack* track : library) {
+        delete track;
+    }
+}
+
+} // namespace
+
+int main() {
+    bench_grow_shrink();
+    bench_adaptive();
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * Shared playlist tracks benchmark
+ *
+ * Builds the library from a config (default input_2/dj_config.txt, first
+ * argument) and loads every playlist in it at once, two ways:
+ * - copies: each playlist owns prepared clones of its tracks, as
+ *   loadPlaylistFromIndices used to build them
+ * - handles: each playlist borrows the library's instances, as it does now
+ * and reports track copies made, heap growth (glibc mallinfo2, including
+ * mmapped blocks) and load time. It then runs waveform analysis
+ * (get_waveform_stats) on every entry, as mixing would, and reports the
+ * waveforms materialised and the heap that costs.
+ * Copies run first so they start from an unprepared library, as before.
+ *
+ * Build and run:  make bench && ./bin/bench_share [config]
+ */
+#include "DJLibraryService.h"
+#include "SessionFileParser.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <malloc.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+size_t heap_in_use() {
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+struct LoadResult {
+    size_t heap_bytes;
+    size_t entries;
+    size_t track_objects;
+    size_t waveforms;
+    size_t waveform_heap_bytes;
+    double ms;
+};
+
+LoadResult load_all(const DJLibraryService& library, const SessionConfig& config, bool copies,
+                    std::vector<std::unique_ptr<Playlist>>& playlists) {
+    const size_t before = heap_in_use();
+    const double start = now_ms();
+    for (const auto& entry : config.playlists) {
+        std::unique_ptr<Playlist> playlist(new Playlist(entry.first, copies));
+        for (int index : entry.second) {
+            if (index < 1 || static_cast<size_t>(index) > config.library_tracks.size()) {
+                continue;
+            }
+            AudioTrack* source = library.findLibraryTrack(config.library_tracks[index - 1].title);
+            AudioTrack* track = copies ? source->clone().release() : source;
+            track->load();
+            track->analyze_beatgrid();
+            playlist->add_track(track);
+        }
+        playlists.push_back(std::move(playlist));
+    }
+    LoadResult result = {0, 0, 0, 0, 0, now_ms() - start};
+    result.heap_bytes = heap_in_use() - before;
+
+    const size_t before_analysis = heap_in_use();
+    std::set<const AudioTrack*> tracks;
+    std::set<const void*> waveforms;
+    for (const std::unique_ptr<Playlist>& playlist : playlists) {
+        for (AudioTrack* track : *playlist) {
+            ++result.entries;
+            tracks.insert(track);
+            track->get_waveform_stats();
+            waveforms.insert(track->get_waveform().raw());
+        }
+    }
+    result.waveform_heap_bytes = heap_in_use() - before_analysis;
+    result.track_objects = copies ? tracks.size() : 0;
+    result.waveforms = waveforms.size();
+    return result;
+}
+
+void report(const char* label, const LoadResult& result) {
+    std::printf("%-8s %8zu %13zu %11zu %9.1f %10zu %15zu\n", label, result.entries, result.track_objects,
+                result.heap_bytes, result.ms, result.waveforms, result.waveform_heap_bytes);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string config_path = argc > 1 ? argv[1] : "input_2/dj_config.txt";
+    SessionConfig config;
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    if (!SessionFileParser::parse_config_file(config_path, config)) {
+        std::cout.rdbuf(saved);
+        std::fprintf(stderr, "cannot parse %s\n", config_path.c_str());
+        return 1;
+    }
+    DJLibraryService library;
+    library.buildLibrary(config.library_tracks);
+
+    std::vector<std::unique_ptr<Playlist>> copied;
+    const LoadResult copies = load_all(library, config, true, copied);
+    copied.clear();
+    std::vector<std::unique_ptr<Playlist>> shared;
+    const LoadResult handles = load_all(library, config, false, shared);
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+
+    std::printf("config: %s (%zu library tracks, %zu playlists)\n", config_path.c_str(),
+                config.library_tracks.size(), config.playlists.size());
+    std::printf("%-8s %8s %13s %11s %9s %10s %15s\n", "mode", "entries", "track copies", "load heap",
+                "load ms", "waveforms", "waveform heap");
+    report("copies", copies);
+    report("handles", handles);
+    const double copies_total = static_cast<double>(copies.heap_bytes + copies.waveform_heap_bytes);
+    const double handles_total = static_cast<double>(handles.heap_bytes + handles.waveform_heap_bytes);
+    std::printf("heap for all playlists: %.0f -> %.0f bytes (%.1f%% saved)\n", copies_total, handles_total,
+                100.0 * (1.0 - handles_total / copies_total));
+    return 0;
+}
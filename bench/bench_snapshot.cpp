@@ -0,0 +1,111 @@
+/**
+ * Config snapshot benchmark
+ *
+ * Writes a synthetic dj_config.txt with N library tracks (default 1M, one
+ * to three artists each) and a few playlists, then times:
+ * - SessionFileParser::parse_config_file (text, the cold-start path)
+ * - ConfigSnapshot::save (paid once, after that parse)
+ * - ConfigSnapshot::load (mmap, every later start)
+ * and checks that both paths produce the same SessionConfig.
+ * Files go to the directory given as the second argument (default /tmp).
+ *
+ * Build and run:  make bench && ./bin/bench_snapshot [tracks] [dir]
+ */
+#include "ConfigSnapshot.h"
+#include "SessionFileParser.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+
+namespace {
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+bool same_config(const SessionConfig& a, const SessionConfig& b) {
+    if (a.library_tracks.size() != b.library_tracks.size() || a.playlists != b.playlists ||
+        a.app_name != b.app_name || a.cache_policy != b.cache_policy ||
+        a.controller_cache_size != b.controller_cache_size || a.bpm_tolerance != b.bpm_tolerance ||
+        a.auto_sync != b.auto_sync) {
+        return false;
+    }
+    for (size_t i = 0; i < a.library_tracks.size(); ++i) {
+        const SessionConfig::TrackInfo& x = a.library_tracks[i];
+        const SessionConfig::TrackInfo& y = b.library_tracks[i];
+        if (x.type != y.type || x.title != y.title || x.artists != y.artists || x.bpm != y.bpm ||
+            x.duration_seconds != y.duration_seconds || x.extra_param1 != y.extra_param1 ||
+            x.extra_param2 != y.extra_param2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t tracks = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+    const std::string dir = argc > 2 ? argv[2] : "/tmp";
+    const std::string config_path = dir + "/bench_snapshot_config.txt";
+    const std::string snapshot_path = ConfigSnapshot::path_for(config_path);
+
+    {
+        std::ofstream out(config_path);
+        out << "app_name=Snapshot Bench\nversion=1.0\ncontroller_cache_size=64\ncache_policy=arc\n";
+        for (size_t i = 0; i < tracks; ++i) {
+            out << "library_track_" << i + 1 << "=" << (i % 2 == 0 ? "MP3" : "WAV")
+                << ",Library Track " << i + 1 << ",{Artist " << i % 1000 << ";";
+            for (size_t extra = 0; extra < i % 3; ++extra) {
+                out << "Guest " << (i + extra) % 400 << ";";
+            }
+            out << "}," << 180 + i % 240 << "," << 90 + i % 60 << ","
+                << (i % 2 == 0 ? "320,1" : "44100,16") << "\n";
+        }
+        for (int p = 0; p < 4; ++p) {
+            out << "bench_set_" << p << "=";
+            for (size_t i = 0; i < 1000 && i < tracks; ++i) {
+                out << (i > 0 ? "," : "") << (i * 7 + p) % tracks + 1;
+            }
+            out << "\n";
+        }
+    }
+    struct stat info;
+    ::stat(config_path.c_str(), &info);
+
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    SessionConfig parsed;
+    double start = now_ms();
+    SessionFileParser::parse_config_file(config_path, parsed);
+    const double parse_ms = now_ms() - start;
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+
+    start = now_ms();
+    const bool saved_ok = ConfigSnapshot::save(snapshot_path, config_path, parsed);
+    const double save_ms = now_ms() - start;
+    struct stat snapshot_info;
+    ::stat(snapshot_path.c_str(), &snapshot_info);
+
+    SessionConfig loaded;
+    start = now_ms();
+    const bool loaded_ok = ConfigSnapshot::load(snapshot_path, config_path, loaded);
+    const double load_ms = now_ms() - start;
+
+    std::printf("tracks: %zu, config %.1f MB, snapshot %.1f MB\n", tracks, info.st_size / 1048576.0,
+                snapshot_info.st_size / 1048576.0);
+    std::printf("parse text config:   %10.1f ms\n", parse_ms);
+    std::printf("write snapshot:      %10.1f ms (%s)\n", save_ms, saved_ok ? "ok" : "FAILED");
+    std::printf("load snapshot:       %10.1f ms (%s, %.1fx faster than parsing)\n", load_ms,
+                loaded_ok && same_config(parsed, loaded) ? "identical config" : "MISMATCH", parse_ms / load_ms);
+
+    std::remove(config_path.c_str());
+    std::remove(snapshot_path.c_str());
+    return 0;
+}
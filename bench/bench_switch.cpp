@@ -0,0 +1,106 @@
+/**
+ * Playlist switching benchmark
+ *
+ * Builds a library of N tracks (default 100k, first argument) and P playlists
+ * of E entries each (default 20 x 5000, second and third arguments), then
+ * plays every playlist in turn (the play_all order) two ways:
+ * - reload: loadPlaylistFromIndices on every switch, as DJSession did
+ * - select: loadPlaylists once, then selectPlaylist on every switch
+ * Both include getTrackTitles(), which the session calls after each switch;
+ * selectPlaylist is also timed alone.
+ * Output is silenced; times are for three passes over all playlists.
+ *
+ * Build and run:  make bench && ./bin/bench_switch [tracks] [playlists] [entries]
+ */
+#include "DJLibraryService.h"
+#include "SessionFileParser.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t tracks = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 100000;
+    const size_t playlist_count = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 20;
+    const size_t entries = argc > 3 ? static_cast<size_t>(std::strtoull(argv[3], nullptr, 10)) : 5000;
+    const int passes = 3;
+
+    std::vector<SessionConfig::TrackInfo> infos(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        SessionConfig::TrackInfo& info = infos[i];
+        info.type = (i % 2 == 0) ? "MP3" : "WAV";
+        info.title = "Library Track " + std::to_string(i + 1);
+        info.artists.push_back("Artist " + std::to_string(i % 1000));
+        info.duration_seconds = 180 + static_cast<int>(i % 240);
+        info.bpm = 90 + static_cast<int>(i % 60);
+        info.extra_param1 = (i % 2 == 0) ? 320 : 44100;
+        info.extra_param2 = (i % 2 == 0) ? 1 : 16;
+    }
+    std::map<std::string, std::vector<int> > configured;
+    for (size_t p = 0; p < playlist_count; ++p) {
+        std::vector<int>& indices = configured["playlist_" + std::to_string(p)];
+        for (size_t e = 0; e < entries; ++e) {
+            indices.push_back(static_cast<int>((p * 7919 + e * 104729) % tracks) + 1);
+        }
+    }
+
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    DJLibraryService library;
+    library.buildLibrary(infos);
+
+    size_t reload_titles = 0;
+    double start = now_ms();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& entry : configured) {
+            library.loadPlaylistFromIndices(entry.first, entry.second);
+            reload_titles += library.getTrackTitles().size();
+        }
+    }
+    const double reload_ms = now_ms() - start;
+
+    start = now_ms();
+    library.loadPlaylists(configured);
+    const double resolve_ms = now_ms() - start;
+    size_t select_titles = 0;
+    start = now_ms();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& entry : configured) {
+            library.selectPlaylist(entry.first);
+            select_titles += library.getTrackTitles().size();
+        }
+    }
+    const double select_ms = now_ms() - start;
+    start = now_ms();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& entry : configured) {
+            library.selectPlaylist(entry.first);
+        }
+    }
+    const double select_only_ms = now_ms() - start;
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+
+    const double switches = static_cast<double>(passes * configured.size());
+    std::printf("library: %zu tracks, %zu playlists x %zu entries, %d passes\n", tracks, playlist_count, entries,
+                passes);
+    std::printf("reload on every switch: %9.1f ms (%.2f ms per switch)\n", reload_ms, reload_ms / switches);
+    std::printf("resolve all once:       %9.1f ms\n", resolve_ms);
+    std::printf("select on every switch: %9.1f ms (%.2f ms per switch)\n", select_ms, select_ms / switches);
+    std::printf("selectPlaylist alone:   %9.4f ms per switch\n", select_only_ms / switches);
+    std::printf("titles: %zu / %zu%s\n", reload_titles, select_titles,
+                reload_titles == select_titles ? "" : "  MISMATCH");
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * Waveform storage format benchmark
+ *
+ * Materialises the waveforms of a synthetic library (1000 tracks x 10000
+ * samples, ~80 MB as float64, well beyond last-level cache) once per
+ * SampleFormat and reports:
+ * - resident sample bytes
+ * - scan time: every sample decoded through AudioTrack::get_waveform_copy
+ * - worst-case quantisation error against float64
+ *
+ * Build and run:  make bench && ./bin/bench_waveform
+ */
+#include "AudioTrack.h"
+#include "WaveformBuffer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+class BenchTrack : public AudioTrack {
+public:
+    BenchTrack(const std::string& title, size_t samples)
+        : AudioTrack(title, std::vector<std::string>(1, "Bench"), 240, 128, samples) {}
+    void load() override {}
+    void analyze_beatgrid() override {}
+    double get_quality_score() const override { return 0.0; }
+    TrackFormat get_format() const override { return TrackFormat::WAV; }
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new BenchTrack(*this));
+    }
+};
+
+double now_ms() {
+    using namespace std::chrono;
+    return static_cast<double>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) / 1000.0;
+}
+
+} // namespace
+
+int main() {
+    const size_t tracks = 1000;
+    const size_t samples = 10000;
+    const SampleFormat formats[] = {SampleFormat::Float64, SampleFormat::Float32,
+                                    SampleFormat::Int16, SampleFormat::MuLaw8};
+
+    // Float64 reference copies of the first track's samples
+    std::vector<double> reference(samples);
+    std::vector<double> scratch(samples);
+
+    std::printf("%-8s %12s %10s %14s %12s\n", "format", "MB resident", "scan ms", "ns/sample", "max error");
+    for (SampleFormat format : formats) {
+        WaveformBuffer::set_default_format(format);
+        std::vector<BenchTrack> library;
+        library.reserve(tracks);
+        for (size_t i = 0; i < tracks; ++i) {
+            library.push_back(BenchTrack("Bench Track " + std::to_string(i), samples));
+            library.back().get_waveform_copy(scratch.data(), 1);
+        }
+        size_t resident = 0;
+        for (const auto& track : library) {
+            resident += track.get_waveform().bytes();
+        }
+
+        double energy = 0.0;
+        double start = now_ms();
+        for (const auto& track : library) {
+            track.get_waveform_copy(scratch.data(), samples);
+            for (size_t s = 0; s < samples; ++s) {
+                energy += scratch[s] * scratch[s];
+            }
+        }
+        double scan_ms = now_ms() - start;
+
+        library.front().get_waveform_copy(scratch.data(), samples);
+        if (format == SampleFormat::Float64) {
+            reference = scratch;
+        }
+        double max_error = 0.0;
+        for (size_t s = 0; s < samples; ++s) {
+            max_error = std::max(max_error, std::fabs(scratch[s] - reference[s]));
+        }
+
+        std::printf("%-8s %12.1f %10.1f %14.2f %12.2e   (energy %.1f)\n",
+                    WaveformBuffer::format_name(format), resident / 1048576.0, scan_ms,
+                    scan_ms * 1e6 / (tracks * samples), max_error, energy);
+    }
+    return 0;
+}
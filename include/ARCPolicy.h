@@ -0,0 +1,43 @@
+#pragma once
+
+#include "EvictionPolicy.h"
+#include <string>
+
+/**
+ * @brief Adaptive Replacement Cache (Megiddo & Modha)
+ *
+ * T1 holds tracks seen once recently, T2 tracks seen at least twice. Ghost
+ * lists B1/B2 remember keys evicted from each side; a miss that hits a ghost
+ * shifts the target size p of T1 towards whichever side would have kept it.
+ * Repeated anthems therefore settle in T2 while one-off tracks cycle
+ * through T1.
+ */
+class ARCPolicy : public EvictionPolicy {
+private:
+    enum Queue { NONE = 0, T1 = 1, T2 = 2 };
+
+    SlotList t1;
+    SlotList t2;
+    GhostList b1;
+    GhostList b2;
+    size_t target_t1;       // p: adaptive target size of T1
+    Queue pending_queue;    // Where the next insert goes (decided in onMiss)
+    bool pending_from_b2;   // Miss was a B2 ghost hit (tie-break in REPLACE)
+
+    void trimGhosts();
+
+public:
+    ARCPolicy()
+        : t1(), t2(), b1(), b2(), target_t1(0), pending_queue(T1), pending_from_b2(false) {}
+
+    const char* name() const override { return "arc"; }
+    void attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) override;
+    void onCapacityChange(size_t cache_capacity) override;
+    void onMiss(const std::string& key) override;
+    void onInsert(size_t idx) override;
+    void onHit(size_t idx) override;
+    void onRemove(size_t idx) override;
+    void onMove(size_t from, size_t to) override;
+    size_t selectVictim() override;
+    void onEvict(size_t idx) override;
+};
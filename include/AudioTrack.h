@@ -2,8 +2,43 @@
 
 #include <string>
 #include "PointerWrapper.h"
+#include "BeatDetector.h"
+#include "InternedString.h"
+#include "WaveformAnalyzer.h"
+#include "WaveformBuffer.h"
+#include <cstdint>
+#include <iosfwd>
 #include <memory>
 #include <vector>
+
+/**
+ * Library track number: 1-based position of the track's entry in
+ * SessionConfig::library_tracks (N for library_track_N), assigned by
+ * DJLibraryService::buildLibrary. Entries of an unknown type are skipped and
+ * leave their number unused. 0 for tracks that are not in the library.
+ */
+typedef uint32_t TrackId;
+
+/**
+ * Container format of a track (one per AudioTrack subclass)
+ */
+enum class TrackFormat : uint8_t {
+    MP3,
+    WAV
+};
+
+/**
+ * Coarse quality band of get_quality_score(): Low below 50, Standard below 75,
+ * High below 90, Studio from 90 (e.g. 128 kbps MP3 is Low, 44.1 kHz/16-bit WAV
+ * is High, 48 kHz/24-bit WAV is Studio)
+ */
+enum class QualityTier : uint8_t {
+    Low,
+    Standard,
+    High,
+    Studio
+};
+
 /**
  * Base class for all audio track types in the DJ library system.
  * This class demonstrates virtual functions, Rule of 5, and dynamic memory management.
@@ -15,16 +50,33 @@
  *   available for compatibility checks; results may be cached per instance.
  * - clone(): used at the cache→mixer boundary; mixer always receives a polymorphic clone
  *   and owns it; the cache retains its own copy.
- * 
+ *
+ * Waveform samples live in a copy-on-write WaveformBuffer: copies and clones
+ * share them, and a copy only gets its own samples once it writes to them.
+ * They are stored in WaveformBuffer::default_format() (float64 unless the
+ * build or waveform_format= in dj_config.txt chooses a compact format).
+ * They are generated lazily on first access, from a seed derived from the
+ * title and artists, so every copy of a track sees the same samples and
+ * tracks that are never analysed cost nothing.
+ * First access is not synchronised: materialise before sharing a track
+ * between threads.
+ *
+ * Accessors never allocate: the title, the artist list and the joined
+ * artist line are returned by reference, and copies share the artist list
+ * instead of duplicating it.
  */
 class AudioTrack {
 protected:
-    std::string title;
-    std::vector<std::string> artists;
+    InternedString title;                  // Pooled: copies and clones share the text
+    TrackId id;                            // Copies and clones keep the library number (fills title's padding)
+    std::shared_ptr<const std::vector<InternedString> > artists;  // Immutable; copies and clones share it
+    InternedString artist_line;            // artists joined with ", ", built once for display
     int duration_seconds;
     int bpm;  // beats per minute for mixing
-    double* waveform_data;  // Dynamic array for audio analysis
-    size_t waveform_size;   // Size of the waveform array
+    size_t waveform_size;             // Samples the waveform has once materialised
+    mutable WaveformBuffer waveform;  // Samples for audio analysis, empty until first access
+    mutable std::shared_ptr<const WaveformStats> waveform_stats;  // Analysis of waveform, shared by copies
+    mutable std::shared_ptr<const BeatGrid> beat_grid;            // Onset detection result, shared by copies
 
 public:
     /**
@@ -37,32 +89,27 @@ public:
     // ========== RULE OF 5 - STUDENTS MUST IMPLEMENT ALL OF THESE ==========
 
     /**
-     * TODO: Implement destructor
-     * HINT: Don't forget to clean up waveform_data!
+     * Destructor: drops this copy's reference to the waveform samples
      */
     virtual ~AudioTrack();
 
     /**
-     * TODO: Implement copy constructor
-     * HINT: Deep copy the waveform_data array
+     * Copy constructor: shares the waveform samples (no allocation)
      */
     AudioTrack(const AudioTrack& other);
 
     /**
-     * TODO: Implement copy assignment operator
-     * HINT: Check for self-assignment, clean up existing data, then deep copy
+     * Copy assignment: shares the waveform samples, releasing the old ones
      */
     AudioTrack& operator=(const AudioTrack& other);
 
     /**
-     * TODO: Implement move constructor
-     * HINT: Transfer ownership without copying, leave other in valid state
+     * Move constructor: takes other's waveform and analysis; other stays valid
      */
     AudioTrack(AudioTrack&& other) noexcept;
 
     /**
-     * TODO: Implement move assignment operator
-     * HINT: Clean up current data, steal from other, reset other
+     * Move assignment: releases this track's waveform, then takes other's
      */
     AudioTrack& operator=(AudioTrack&& other) noexcept;
 
@@ -91,20 +138,119 @@ public:
      */
     virtual double get_quality_score() const = 0;
 
+    /**
+     * Band of get_quality_score()
+     */
+    QualityTier get_quality_tier() const;
+
+    /**
+     * Pure virtual function - the track's container format
+     */
+    virtual TrackFormat get_format() const = 0;
+
     /**
      * Pure virtual function - create a copy of this track
      * Demonstrates the prototype pattern with polymorphism
      */
     virtual PointerWrapper<AudioTrack> clone() const = 0;
 
+    /**
+     * Bytes of memory this track occupies: the object itself, its audio data
+     * (audio_bytes()) and what it owns on the heap (waveform buffer, analysis
+     * results and artist id vector). The waveform is charged at the size it
+     * has once materialised, so the cost does not change when it is built.
+     * A shared waveform is counted in full, so budgets stay an upper bound.
+     * Title and artist text is interned and accounted for by
+     * InternedString::pool_stats() instead.
+     * Derived classes override to report their own object size.
+     */
+    virtual size_t memory_footprint() const { return sizeof(AudioTrack) + audio_bytes() + heap_footprint(); }
+
+    /**
+     * Bytes of audio data a loaded track holds, which depends on its format
+     */
+    virtual size_t audio_bytes() const { return 0; }
+
     /**
      * Function to get a copy of the waveform data
+     * Samples are converted to double from the stored SampleFormat.
      */
     void get_waveform_copy(double* buffer, size_t buffer_size) const;
+
+    /**
+     * Read-only waveform in its stored format (for analysis kernels)
+     */
+    const WaveformBuffer& get_waveform() const { return waveform_buffer(); }
+
+    /**
+     * Level analysis of the waveform (RMS, peak, crest factor, zero crossings, envelope)
+     * Computed on first call and kept until the waveform is written; copies
+     * made afterwards share the result.
+     */
+    const WaveformStats& get_waveform_stats() const;
+
+    /**
+     * Tempo and beat positions detected in the waveform (see BeatDetector)
+     * The waveform's sample rate is waveform size / duration. Waveforms too
+     * coarse to resolve a tempo are rejected without being generated. The
+     * result is memoised like get_waveform_stats(), so clones and re-loads
+     * of an analysed track never run detection again.
+     */
+    const BeatGrid& get_beat_grid() const;
+
+    /**
+     * Overwrite waveform samples from offset; unshares them first if other copies hold them
+     * Discards the cached waveform analysis and beat grid.
+     * @return Number of samples written
+     */
+    size_t write_waveform(size_t offset, const double* samples, size_t count);
     
     // ========== ACCESSOR FUNCTIONS ==========
-    std::string get_title() const { return title; }
+    const std::string& get_title() const { return title.str(); }
+    InternedString get_title_id() const { return title; }  // O(1) title equality
+    TrackId get_id() const { return id; }
     int get_bpm() const { return bpm; }
     int get_duration() const { return duration_seconds; }
-    std::vector<std::string> get_artists() const { return artists; }
+    const std::vector<InternedString>& get_artists() const { return *artists; }
+    const std::string& get_artist_line() const { return artist_line.str(); }  // "A, B" (no copy)
+
+    /**
+     * Set BPM (used by MixingEngineService::sync_bpm on the mixer's own clone)
+     */
+    void set_bpm(int new_bpm) { bpm = new_bpm; }
+
+    /**
+     * Set the library track number (DJLibraryService::buildLibrary)
+     */
+    void set_id(TrackId track_id) { id = track_id; }
+
+    /**
+     * Stream that track constructors log to on the calling thread (std::cout
+     * unless redirected). DJLibraryService's parallel build gives each worker
+     * its own buffer, then prints them in library order.
+     */
+    static std::ostream& construction_log();
+
+    /**
+     * Redirect this thread's construction log (nullptr restores std::cout)
+     */
+    static void set_construction_log(std::ostream* stream);
+
+protected:
+    /**
+     * Heap bytes owned by the AudioTrack part of this object
+     */
+    size_t heap_footprint() const;
+
+    /**
+     * Beat count for analyze_beatgrid(): from onset detection when the waveform
+     * yields a tempo, else duration * bpm. The detected tempo stays in
+     * get_beat_grid().bpm; the metadata BPM (indexed by the library) is not changed.
+     */
+    int estimate_beats() const;
+
+    /**
+     * The waveform, generated on first call
+     */
+    WaveformBuffer& waveform_buffer() const;
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "WaveformBuffer.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Tempo and beat positions found in a waveform
+ */
+struct BeatGrid {
+    bool detected = false;                // false: too coarse, too short or no periodicity
+    double bpm = 0.0;                     // Estimated tempo
+    double confidence = 0.0;              // Normalised autocorrelation at the beat period (0..1)
+    std::vector<double> beat_times = {};  // Beat positions in seconds from the start
+};
+
+/**
+ * @brief Onset-based tempo estimation (Helper)
+ *
+ * Pipeline:
+ * 1. Spectral flux: Hann-windowed STFT (FFT, ~46 ms frames, 75% overlap);
+ *    positive change in log magnitude summed over bins, per frame.
+ * 2. Autocorrelation of the mean-removed flux, via FFT (O(n log n)).
+ * 3. Comb filter over 60-200 BPM: autocorrelation at 1-4 beat periods,
+ *    weighted by a log-normal prior around 120 BPM to settle octave ties.
+ * 4. Beat phase: the offset whose beat comb collects the most flux.
+ *
+ * A waveform can only be analysed if its sample rate yields an onset
+ * envelope fast enough to resolve MAX_BPM; can_resolve() checks this without
+ * touching the samples, so coarse overview waveforms are never materialised.
+ */
+class BeatDetector {
+public:
+    static constexpr double MIN_BPM = 60.0;
+    static constexpr double MAX_BPM = 200.0;
+    static constexpr double MIN_CONFIDENCE = 0.1;
+
+    /**
+     * @brief Can count samples at sample_rate Hz be analysed at all?
+     */
+    static bool can_resolve(size_t count, double sample_rate);
+
+    /**
+     * @brief Detect tempo and beats in a waveform of any SampleFormat
+     */
+    static BeatGrid detect(const WaveformBuffer& waveform, double sample_rate);
+
+    /**
+     * @brief Detect tempo and beats in count float64 samples
+     */
+    static BeatGrid detect(const double* samples, size_t count, double sample_rate);
+
+    /**
+     * @brief Spectral flux onset envelope (step 1)
+     * @param envelope_rate Output: envelope frames per second
+     */
+    static std::vector<double> onset_envelope(const double* samples, size_t count, double sample_rate,
+                                              double& envelope_rate);
+
+    /**
+     * @brief Autocorrelation r[0..max_lag] of x, via FFT (step 2)
+     */
+    static std::vector<double> autocorrelation(const std::vector<double>& x, size_t max_lag);
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "EvictionPolicy.h"
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Belady's optimal (MIN) eviction for a known access sequence
+ *
+ * A playlist fixes the future, so the best possible victim is the resident
+ * track whose next use is farthest away (or that is never used again).
+ * Each slot's frequency field stores its next-use position; an ordered set
+ * over (next use, slot) yields the victim in O(log n). Without a plan every
+ * next use is "never" and the policy degenerates to an arbitrary choice.
+ */
+class BeladyPolicy : public EvictionPolicy {
+private:
+    static const uint64_t NEVER = static_cast<uint64_t>(-1);
+
+    std::unordered_map<std::string, std::vector<size_t> > occurrences;  // key -> sorted positions
+    size_t next_position;                                              // First unserved position
+    std::set<std::pair<uint64_t, size_t> > by_next_use;                // (next use, slot)
+
+    uint64_t nextUse(const std::string& key) const;
+    void track(size_t idx);
+    void untrack(size_t idx);
+
+public:
+    BeladyPolicy() : occurrences(), next_position(0), by_next_use() {}
+
+    const char* name() const override { return "belady"; }
+    void attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) override;
+    void onInsert(size_t idx) override;
+    void onHit(size_t idx) override;
+    void onRemove(size_t idx) override;
+    void onMove(size_t from, size_t to) override;
+    size_t selectVictim() override;
+    void onPlan(const std::vector<std::string>& sequence) override;
+    void onAdvance(size_t position) override;
+    bool admitPrefetch(const std::string& key) const override;
+};
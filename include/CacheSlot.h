@@ -1,9 +1,11 @@
 #pragma once
 
 #include "AudioTrack.h"
+#include "InternedString.h"
 #include "PointerWrapper.h"
 #include <cstddef>
 #include <cstdint>
+#include <string>
 
 /**
  * @brief Single Cache Entry with LRU Metadata (Single Responsibility)
@@ -16,14 +18,30 @@
  * - Each slot holds exactly one cached track instance owned by the controller.
  * - access() updates last_access_time to reflect MRU/LRU policy.
  * - clear() releases ownership; callers log evictions as needed.
+ *
+ * Slots also carry intrusive, policy-owned metadata: prev/next links (slot
+ * indices) so an EvictionPolicy can thread them into its lists without any
+ * extra allocation, plus a frequency counter and a small tag (queue id,
+ * reference bit). Empty slots are chained into the cache's free list through
+ * next. The slot never interprets these fields itself.
  */
 class CacheSlot {
+public:
+    static const size_t NIL = static_cast<size_t>(-1);  // "no neighbour" link value
+
 private:
     PointerWrapper<AudioTrack> track;    // The cached track
+    InternedString key;                  // Cache key (interned title), captured once at store()
+    size_t bytes;                        // Track memory footprint, captured once at store()
     uint64_t last_access_time;           // For LRU algorithm
     bool occupied;                       // Is this slot in use?
 
 public:
+    size_t prev;                         // Towards list head (policy list) / unused (free list)
+    size_t next;                         // Towards list tail (policy list) / next free slot
+    uint64_t frequency;                  // Policy-owned access counter (LFU)
+    unsigned tag;                        // Policy-owned marker (queue id, reference bit)
+
     /**
      * @brief Construct empty cache slot
      */
@@ -47,6 +65,12 @@ public:
      * @brief Clear this slot (removes track)
      */
     void clear();
+
+    /**
+     * @brief Take the track out of this slot without destroying it
+     * @return Owning wrapper to the stored track; the slot becomes empty
+     */
+    PointerWrapper<AudioTrack> take();
     
     /**
      * @brief Check if slot is occupied
@@ -62,4 +86,19 @@ public:
      * @brief Get track without updating access time
      */
     AudioTrack* getTrack() const { return track.get(); }
-};
\ No newline at end of file
+
+    /**
+     * @brief Get the key the track was stored under
+     */
+    const std::string& getKey() const { return key.str(); }
+
+    /**
+     * @brief Get the key as its intern id (what LRUCache indexes by)
+     */
+    InternedString getKeyId() const { return key; }
+
+    /**
+     * @brief Memory footprint of the stored track (0 when empty)
+     */
+    size_t getBytes() const { return bytes; }
+};
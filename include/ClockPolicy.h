@@ -0,0 +1,26 @@
+#pragma once
+
+#include "EvictionPolicy.h"
+
+/**
+ * @brief CLOCK (second-chance) eviction
+ *
+ * A hand sweeps the slot array; each slot's tag is its reference bit. Hits
+ * set the bit, the sweep clears it, and the first slot found with a clear
+ * bit is evicted. Hits cost a single store and never reorder anything.
+ */
+class ClockPolicy : public EvictionPolicy {
+private:
+    size_t hand;
+
+public:
+    ClockPolicy() : hand(0) {}
+
+    const char* name() const override { return "clock"; }
+    void attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) override;
+    void onInsert(size_t idx) override;
+    void onHit(size_t idx) override;
+    void onRemove(size_t idx) override;
+    void onCapacityChange(size_t cache_capacity) override;
+    size_t selectVictim() override;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "SessionFileParser.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Binary snapshot of a parsed SessionConfig, for fast startup (Helper)
+ *
+ * DJSession writes one next to the text config (<config>.snap) after parsing
+ * it, and on later runs maps it with mmap instead of parsing the text again.
+ * A snapshot records the text file's size and modification time and is only
+ * used while both still match, so editing the config sends the next start
+ * back through SessionFileParser, which then rewrites the snapshot. Parser
+ * warnings are therefore printed on the parsing run only.
+ *
+ * Layout (native byte order; every section 8-byte aligned):
+ *   Header | tracks[] | artist refs[] | playlists[] | playlist indices[] | string pool
+ * Strings are (offset, length) references into a deduplicated pool. The
+ * header is checked for magic, VERSION and byte order, and every section and
+ * reference is bounds-checked on load, so a stale, truncated or foreign file
+ * is rejected rather than trusted. Bump VERSION whenever SessionConfig or the
+ * layout changes.
+ */
+class ConfigSnapshot {
+public:
+    static const uint32_t VERSION = 3;
+
+    /**
+     * @brief Where the snapshot of config_path lives
+     */
+    static std::string path_for(const std::string& config_path);
+
+    /**
+     * @brief Fill config from snapshot_path if it is valid and matches config_path
+     * @return false (config untouched) if the snapshot is missing, stale or invalid
+     */
+    static bool load(const std::string& snapshot_path, const std::string& config_path, SessionConfig& config);
+
+    /**
+     * @brief Write config as the snapshot of config_path (atomically, via rename)
+     * @return false if config_path cannot be stat'ed or the file cannot be written
+     */
+    static bool save(const std::string& snapshot_path, const std::string& config_path,
+                     const SessionConfig& config);
+};
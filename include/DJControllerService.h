@@ -4,20 +4,61 @@
 #include "LRUCache.h"
 #include "CacheSlot.h"
 #include "PointerWrapper.h"
+#include "ShardedCache.h"
+#include "TinyLFU.h"
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 /**
  * Service responsible for managing the controller's memory (cache)
- * Cache capacity is fixed, and the tracks are managed with LRU policy.
+ * Cache capacity is fixed, and the tracks are managed with LRU policy by default
+ * (LFU, CLOCK, ARC and 2Q can be selected with set_cache_policy).
+ * Capacity is a slot count unless a byte budget is set (set_cache_bytes), in
+ * which case tracks are evicted until the new track's memory fits.
  * On HIT: touch MRU (most recently used); on MISS: insert; if full, evict LRU.
  * - Mixer always receives a polymorphic clone; cache retains its copy.
+ * - Optional prefetch: upcoming tracks can be cached ahead of their demand load;
+ *   their fate (later HIT, or evicted unused) is recorded in PrefetchStats.
+ * - Optional shared mode (set_shared_cache): demand loads go to a ShardedCache
+ *   that controllers on other threads use too.
+ * - Optional admission filter (set_cache_admission): a demand miss that would
+ *   evict is cached only if TinyLFU rates it above the victim; a rejected
+ *   track is played straight from the library, without a clone.
+ * - The slot count can change mid-session (resize_cache), by hand or by
+ *   adaptive sizing (set_adaptive_sizing), which hill-climbs on the hit rate
+ *   of successive windows of demand loads under a memory ceiling.
  */
 class DJControllerService {
 public:
+    struct PrefetchStats {
+        size_t issued = 0;              // Tracks inserted ahead of demand
+        size_t hits = 0;                // Demand loads served by a prefetched copy
+        size_t wasted = 0;              // Prefetched copies evicted before any demand load
+        double stall_avoided_ms = 0.0;  // Load time moved off the demand path by prefetch hits
+    };
+
+    struct AdmissionStats {
+        size_t admitted = 0;  // Demand misses that displaced a victim after winning the comparison
+        size_t rejected = 0;  // Demand misses left uncached because the victim was requested more
+    };
+
+    struct ResizeStats {
+        size_t grown = 0;    // resize_cache calls that added slots
+        size_t shrunk = 0;   // ... that removed slots
+        size_t evicted = 0;  // Tracks evicted to fit a smaller cache
+    };
+
     // Construct with a given cache size
     explicit DJControllerService(size_t cache_size = 8);
 
+    // Owns a non-copyable cache and points into the library; never copy
+    DJControllerService(const DJControllerService&) = delete;
+    DJControllerService& operator=(const DJControllerService&) = delete;
+
     // Contract: Ensure a track is present in cache by key (full playlist line)
+    // In shared mode the track stays valid until this controller's next cache call.
     // Input: A reference to an AudioTrack.
     // Output: An integer indicating the result: 1 for HIT, 0 for MISS without eviction, -1 for MISS with eviction.
     int loadTrackToCache(AudioTrack& track);
@@ -25,23 +66,164 @@ public:
 
     // Contract: Display cache status (LRU order and occupancy)
     // - Intended for debugging and interactive inspection
-    void displayCacheStatus() const; // TODO: Implement
+    void displayCacheStatus() const;
 
     /**
-     * @brief Set the cache size for the LRUCache.
+     * @brief Set the cache size for the LRUCache (startup configuration; prints nothing).
      * @param new_size The new size for the cache.
-     * @note This function is meant for a single usage. don't call it more then once.
      */
     void set_cache_size(size_t new_size);
+
+    /**
+     * @brief Resize the cache during a session, reporting the change and each eviction.
+     * @param new_size New slot count; shrinking evicts in policy order.
+     * @return Titles evicted to fit, in eviction order.
+     */
+    std::vector<std::string> resize_cache(size_t new_size);
+
+    /**
+     * @brief Let the controller resize the cache from the observed hit rate.
+     * After every max(window, 4 x slots) demand loads (larger caches need
+     * longer samples to show a difference) the slot count moves by a quarter
+     * (at least one slot): on in the same direction while the hit rate rises,
+     * reversing when it falls, and shrinking when it is flat (the same hits
+     * for less memory). Growth stops where the cached tracks' mean footprint
+     * times the slot count would exceed memory_ceiling.
+     * @param memory_ceiling Bytes of track memory; 0 turns adaptive sizing off.
+     * @param window Minimum demand loads per hit-rate sample.
+     */
+    void set_adaptive_sizing(size_t memory_ceiling, size_t window = 16);
+
+    bool get_adaptive_sizing() const { return adaptive_ceiling > 0; }
+    size_t get_cache_capacity() const { return cache.capacity(); }
+    const ResizeStats& get_resize_stats() const { return resize_stats; }
+
+    /**
+     * @brief Limit the cache by track memory instead of slot count.
+     * @param bytes Budget in bytes; 0 keeps slot counting.
+     */
+    void set_cache_bytes(size_t bytes);
+
+    /**
+     * @brief Byte budget, or 0 when the cache is limited by slot count.
+     */
+    size_t get_cache_bytes() const { return cache.byte_budget(); }
+
+    /**
+     * @brief Memory currently held by cached tracks, and its high-water mark.
+     */
+    size_t get_cache_memory_used() const { return cache.memory_used(); }
+    size_t get_cache_memory_peak() const { return cache.memory_peak(); }
+
+    /**
+     * @brief Select the cache eviction policy by name.
+     * @param policy_name One of "lru", "lfu", "clock", "arc", "2q".
+     * @return true if the policy exists and is now active; false leaves the current policy.
+     */
+    bool set_cache_policy(const std::string& policy_name);
+
+    /**
+     * @brief Name of the active cache eviction policy.
+     */
+    const char* get_cache_policy() const { return cache.policy_name(); }
     /**
      * @brief Get a track from the cache by its title.
      * @param track_title The title of the track to retrieve.
      * @return A raw pointer to the track if found, otherwise nullptr. Does not transfer ownership.
+     * @note Counts no access: the loadTrackToCache call before it already did.
      */
     AudioTrack* getTrackFromCache(const std::string& track_title);
 
+    /**
+     * @brief Get a track from the cache by its library track number.
+     * @param track_id AudioTrack::get_id() of a track passed to loadTrackToCache.
+     * @return As the title overload; nullptr for ids this controller never loaded.
+     *         Looks the track up by integer key without touching its title.
+     */
+    AudioTrack* getTrackFromCache(TrackId track_id);
+
+    /**
+     * @brief Cache a track ahead of its demand load.
+     * @param track Library track expected to be requested soon.
+     * @return true if a copy was inserted; false if already cached, refused by the policy, or clone failed.
+     * @note Does not refresh recency of tracks that are already cached.
+     */
+    bool prefetchTrack(AudioTrack& track);
+
+    /**
+     * @brief Announce the order tracks will be requested in (enables Belady eviction).
+     */
+    void planAccesses(const std::vector<std::string>& track_titles);
+
+    /**
+     * @brief Mark access number `position` of the planned order as the current one.
+     */
+    void advanceTo(size_t position);
+
+    const PrefetchStats& get_prefetch_stats() const { return prefetch_stats; }
+
+    /**
+     * @brief Select the admission filter in front of the private cache by name.
+     * @param filter_name "none" (every miss is cached) or "tinylfu".
+     * @return true if the filter exists and is now active; false leaves the current one.
+     * @note The sketch is sized from the cache capacity and re-sized, keeping
+     *       its counts, whenever the capacity changes. Prefetches and the shared cache are not filtered.
+     */
+    bool set_cache_admission(const std::string& filter_name);
+
+    /**
+     * @brief Name of the active admission filter ("none" or "tinylfu").
+     */
+    const char* get_cache_admission() const { return admission ? "tinylfu" : "none"; }
+
+    const AdmissionStats& get_admission_stats() const { return admission_stats; }
+
+    /**
+     * @brief Serve demand loads from a cache shared with other controllers (other threads)
+     * loadTrackToCache, getTrackFromCache and displayCacheStatus use it instead of the
+     * private cache; prefetch, access plans, policies and budgets stay on the private one.
+     * @param shared The shared cache; nullptr returns to the private cache.
+     */
+    void set_shared_cache(const std::shared_ptr<ShardedCache>& shared);
+
 private:
     LRUCache cache;
+    std::shared_ptr<ShardedCache> shared_cache;
+    std::shared_ptr<AudioTrack> pinned;  // Last shared track handed out; keeps it alive until the next call
+    // Prefetched, not yet used: (title, load time in ms); at most one prefetch window long
+    std::vector<std::pair<InternedString, double> > pending_prefetches;
+    PrefetchStats prefetch_stats;
+    PointerWrapper<TinyLFU> admission;  // Empty when every miss is admitted
+    AdmissionStats admission_stats;
+    AudioTrack* bypass;  // Library track last refused admission; served until the next load
+    std::vector<InternedString> track_keys;  // TrackId -> cache key, recorded by loadTrackToCache
+    ResizeStats resize_stats;
+    size_t adaptive_ceiling;   // Bytes; 0 = fixed slot count
+    size_t adaptive_window;    // Minimum demand loads per hit-rate sample
+    size_t window_loads;
+    size_t window_hits;
+    double last_window_rate;   // Hit rate of the previous window, or -1 before the first
+    bool growing;              // Direction of the next adaptive step
+
+    /**
+     * @brief loadTrackToCache against the private cache
+     */
+    int loadTrackToPrivateCache(AudioTrack& track, const std::string& title);
+
+    /**
+     * @brief Count one demand load toward the current window; resize when it is complete
+     */
+    void adaptCapacity(bool hit);
+
+    /**
+     * @brief loadTrackToCache against shared_cache
+     */
+    int loadTrackToSharedCache(AudioTrack& track, const std::string& title);
+
+    /**
+     * @brief Count prefetched tracks that an eviction removed before use as wasted
+     */
+    void collectWastedPrefetches();
 };
 
 #endif // DJCONTROLLERSERVICE_H
@@ -4,8 +4,11 @@
 #include "Playlist.h"
 #include "AudioTrack.h"
 #include "SessionFileParser.h"
+#include "TrackMetadataTable.h"
+#include <map>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 // Service responsible for managing the track library and playlists
 // Phase 4 behavior alignment:
@@ -15,6 +18,11 @@ class DJLibraryService {
 public:
     DJLibraryService(const Playlist& playlist);
     DJLibraryService() = default;
+    ~DJLibraryService();
+
+    // The library owns raw track pointers; copying would double-delete them
+    DJLibraryService(const DJLibraryService&) = delete;
+    DJLibraryService& operator=(const DJLibraryService&) = delete;
 
     /**
      * @brief Build the track library from parsed config data
@@ -22,14 +30,52 @@ public:
      */
     void buildLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks);
 
+    /**
+     * @brief Worker threads for buildLibrary (0 = one per hardware thread; default 1)
+     * Large configs are split into contiguous chunks, one per worker; small
+     * ones (under 4096 tracks per worker) are built serially regardless.
+     */
+    void set_build_threads(size_t threads);
+    size_t get_build_threads() const { return build_threads; }
+
+    /**
+     * @brief Print per-track construction lines during buildLibrary (default on)
+     * Parallel builds buffer them per worker and print in library order.
+     */
+    void set_build_logging(bool enabled) { build_logging = enabled; }
+
     /**
      * @brief Load a playlist by constructing it from track indices
+     * The playlist holds handles to the library's tracks (no copies), which
+     * stay valid for the life of the service.
      * @param playlist_name Name of the playlist
      * @param track_indices Vector of 1-based track indices referencing the library
      */
     void loadPlaylistFromIndices(const std::string& playlist_name, const std::vector<int>& track_indices);
 
-    // Returns a reference to the loaded playlist
+    /**
+     * @brief Resolve every configured playlist once and hold them all, addressed by name
+     * Each referenced library track is prepared (load + beatgrid analysis) the
+     * first time any playlist uses it; the playlists hold handles. Replaces
+     * playlists from an earlier call and makes none of them current.
+     * @param playlists Playlist name -> 1-based library indices (SessionConfig::playlists)
+     * @param prepare_tracks false resolves handles only, skipping load and
+     *        analysis (enough for getTrackTitles/getTrackIds)
+     */
+    void loadPlaylists(const std::map<std::string, std::vector<int> >& playlists, bool prepare_tracks = true);
+
+    /**
+     * @brief Make a playlist resolved by loadPlaylists the current one (O(1), nothing is reloaded)
+     * @return false if no playlist has that name
+     */
+    bool selectPlaylist(const std::string& playlist_name);
+
+    /**
+     * @brief A playlist resolved by loadPlaylists, or nullptr
+     */
+    const Playlist* findPlaylist(const std::string& playlist_name) const;
+
+    // Returns a reference to the current playlist (the last loaded or selected)
     Playlist& getPlaylist();
 
     // Display all playlists in the library (debug aid; optional for Phase 4)
@@ -37,21 +83,79 @@ public:
 
     /**
      * @brief Find a track in the library by its title.
+     * The loaded playlist's (prepared) track is preferred; otherwise the library entry.
+     * Both lookups are O(1) hash-index lookups.
      * @param track_title The title of the track to find.
      * @return A raw pointer to the AudioTrack if found, otherwise nullptr.
      * The library retains ownership of the track.
      */
     AudioTrack* findTrack(const std::string& track_title);
 
+    /**
+     * @brief Find a library entry by title, ignoring the loaded playlist
+     * @return The first track built with that title, or nullptr
+     */
+    AudioTrack* findLibraryTrack(const std::string& track_title) const;
+
+    /**
+     * @brief A library track by number (AudioTrack::get_id(), assigned by buildLibrary)
+     * Ids follow the library_track_N numbering, skipped entries included. O(1), no hashing.
+     * @return The track, or nullptr for 0, a skipped entry or an id past the library
+     */
+    AudioTrack* getTrack(TrackId track_id) const;
+
+    /**
+     * @brief All library tracks crediting an artist (exact, case-sensitive name)
+     * @return Tracks in library order; empty if the artist is unknown. O(1).
+     */
+    const std::vector<AudioTrack*>& findTracksByArtist(const std::string& artist) const;
+
+    /**
+     * @brief All library tracks with bpm - tolerance <= BPM <= bpm + tolerance
+     * @return Tracks ordered by BPM (library order within a BPM). O(log n + k).
+     */
+    std::vector<AudioTrack*> findTracksByBpm(int bpm, int tolerance) const;
+
+    /**
+     * @brief Columnar metadata of the library (row = 1-based track index - 1)
+     * For library-wide scans and totals without touching the track objects.
+     */
+    const TrackMetadataTable& getMetadata() const { return metadata; }
+
     /**
      * @brief Get a vector of all track titles in the current playlist.
      * @return A vector of strings containing the track titles.
      */
     std::vector<std::string> getTrackTitles() const;
 
+    /**
+     * @brief Library ids of the current playlist's tracks, in getTrackTitles() order
+     */
+    std::vector<TrackId> getTrackIds() const;
+
 private:
-    Playlist playlist;
-    std::vector<AudioTrack*> library;  // Library of all tracks (owned)
+    Playlist playlist;  // Built by loadPlaylistFromIndices or the constructor
+    std::unordered_map<std::string, Playlist> playlists = {};  // Resolved by loadPlaylists, by name
+    Playlist* current = &playlist;  // playlist or an entry of playlists
+    std::vector<bool> prepared = {};  // prepared[i]: library[i] was loaded and analysed by loadPlaylists
+    std::vector<AudioTrack*> library = {};  // Library of all tracks (owned; playlists hold handles)
+    std::vector<AudioTrack*> by_id = {};  // by_id[N - 1]: track with id N, or nullptr for a skipped entry
+    std::unordered_map<std::string, AudioTrack*> library_index = {};  // title -> first library track
+    std::unordered_map<std::string, std::vector<AudioTrack*> > artist_index = {};  // artist -> tracks
+    std::vector<std::pair<int, AudioTrack*> > bpm_index = {};  // (BPM, track), sorted by BPM
+    TrackMetadataTable metadata = {};  // Row i describes library[i]
+    size_t build_threads = 1;
+    bool build_logging = true;
+
+    // Construct tracks for library_tracks into built[i] on workers threads
+    void construct_parallel(const std::vector<SessionConfig::TrackInfo>& library_tracks,
+                            std::vector<AudioTrack*>& built, size_t workers);
+
+    // Add built tracks (aligned with library_tracks; nullptr = skipped) to the
+    // title, artist and BPM indexes and the metadata table; parallel runs
+    // each on its own thread
+    void index_tracks(const std::vector<AudioTrack*>& built,
+                      const std::vector<SessionConfig::TrackInfo>& library_tracks, bool parallel);
 };
 
 #endif // DJLIBRARYSERVICE_H
@@ -5,6 +5,8 @@
 #include "MixingEngineService.h"
 #include "SessionFileParser.h"
 #include "ConfigurationManager.h"
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -39,9 +41,11 @@ private:
     ConfigurationManager config_manager;
     SessionConfig session_config;
     std::vector<std::string> track_titles;
+    std::vector<TrackId> track_ids = {};  // Library ids of track_titles, same order
     bool play_all = false;
     // Session statistics
     struct SessionStats {
+        std::string cache_policy = "LRU";  // Policy the cache counters below were measured with
         size_t tracks_processed = 0;
         size_t cache_hits = 0;
         size_t cache_misses = 0;
@@ -50,7 +54,14 @@ private:
         size_t deck_loads_b = 0;
         size_t transitions = 0;
         size_t errors = 0;
-    } stats;
+        size_t prefetches_issued = 0;
+        size_t prefetch_hits = 0;
+        size_t prefetches_wasted = 0;
+        double stall_avoided_ms = 0.0;
+        size_t admissions = 0;      // Misses the admission filter let displace a victim
+        size_t rejections = 0;      // Misses it left uncached
+    } stats;                                             // Whole session
+    std::map<std::string, SessionStats> playlist_stats = {};  // Per playlist played, by name
 
 public:
     // ========== CONSTRUCTORS & DESTRUCTOR ==========
@@ -70,8 +81,9 @@ public:
 
 
     /**
-     * Contract: Load playlist into the session library
+     * Contract: Make a playlist the current one
      * - Input: playlist name (key from session config)
+     * - Playlists are resolved once, when the session starts; switching reloads nothing
      * - Output: true on success; false if playlist not found or empty
      */
     bool load_playlist(const std::string& playlist_name);
@@ -83,6 +95,12 @@ public:
      */
     int load_track_to_controller(const std::string& track_name);
 
+    /**
+     * Contract: load_track_to_controller by library id (the playback path)
+     * - No title lookups: the track and its cache entry are found by integer key
+     */
+    int load_track_to_controller(TrackId track_id);
+
     /**
      * Contract: Load a cached track into a mixer deck (instant-transition model)
      * - Input: track title (or key).
@@ -90,19 +108,61 @@ public:
      */
     bool load_track_to_mixer_deck(const std::string& track_title);
 
+    /**
+     * Contract: load_track_to_mixer_deck by library id (the playback path)
+     */
+    bool load_track_to_mixer_deck(TrackId track_id);
+
+    /**
+     * Contract: Cache the tracks that follow `position` in the current playlist
+     * - Looks ahead session_config.prefetch_lookahead titles; no-op when that is 0
+     * - Runs after a deck load, i.e. while the current track is playing
+     */
+    void prefetch_upcoming_tracks(size_t position);
+
     /**
      * Contract: Orchestrate the DJ performance simulation
      */
     void simulate_dj_performance();
 
+    /**
+     * Contract: Offline cache sizing - LRU hit rate for every capacity, per playlist
+     * - Builds the library and resolves the playlists as a session does, so each
+     *   trace is the order tracks are played in; nothing is loaded, cached or mixed
+     * - Each playlist is analyzed from a cold cache, then all playlists back to back
+     *   (the play_all order, with the cache carried over)
+     * - Input: optional CSV path; when non-empty the curves are also exported there
+     * - Output: true on success; false if the configuration or export file fails
+     */
+    bool analyze_cache_sizing(const std::string& export_path = "");
+
 
     // ========== STATUS & DISPLAY METHODS ==========
 
     const std::string& get_session_name() const { return session_name; }
 
+    /**
+     * @brief Serve this session's controller from a cache shared with other sessions
+     * - Sessions on other threads may hold the same cache; nullptr returns to a private cache
+     */
+    void use_shared_cache(const std::shared_ptr<ShardedCache>& cache) { controller_service.set_shared_cache(cache); }
+
     // TODO: Add more status and display methods as needed, delegating to services
 
 private:
+    // ========== TRACK TRANSFER ==========
+
+    /**
+     * @brief Shared tail of both load_track_to_controller overloads
+     */
+    int load_library_track_to_controller(AudioTrack& track);
+
+    /**
+     * @brief Shared tail of both load_track_to_mixer_deck overloads
+     * @param track The cached track, or nullptr on a cache miss
+     */
+    bool load_cached_track_to_mixer_deck(const std::string& track_title, AudioTrack* track);
+
     // ========== PROVIDED HELPER METHODS (Menu and Config) ==========
     
     /**
@@ -116,6 +176,11 @@ private:
      * @return Selected playlist name, or empty string if cancelled
      */
     std::string display_playlist_menu_from_config();
+    /**
+     * @brief Add the counters gained since before to playlist_name's stats
+     */
+    void record_playlist_stats(const std::string& playlist_name, const SessionStats& before);
+
     /**
      * @brief Print final session summary with statistics
      */
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "CacheSlot.h"
+#include "PointerWrapper.h"
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Intrusive doubly-linked list of cache slots (Helper)
+ *
+ * Threads slot indices through CacheSlot::prev/next. Head is the "newest"
+ * end, tail the "oldest". A slot may be on at most one SlotList at a time.
+ */
+class SlotList {
+private:
+    size_t head_idx;
+    size_t tail_idx;
+    size_t length;
+
+public:
+    SlotList() : head_idx(CacheSlot::NIL), tail_idx(CacheSlot::NIL), length(0) {}
+
+    void pushFront(std::vector<CacheSlot>& slots, size_t idx);
+    void remove(std::vector<CacheSlot>& slots, size_t idx);
+    // Slot from's contents, links included, were moved to slot to: repoint its neighbours
+    void relink(std::vector<CacheSlot>& slots, size_t from, size_t to);
+    void clear() { head_idx = tail_idx = CacheSlot::NIL; length = 0; }
+
+    size_t head() const { return head_idx; }
+    size_t tail() const { return tail_idx; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+};
+
+/**
+ * @brief Bounded FIFO of evicted keys (Helper)
+ *
+ * "Ghost" entries remember recently evicted keys without holding tracks,
+ * so adaptive policies (ARC, 2Q) can recognise a quick re-reference.
+ */
+class GhostList {
+private:
+    std::list<std::string> order;   // front = newest
+    std::unordered_map<std::string, std::list<std::string>::iterator> lookup;
+
+public:
+    GhostList() : order(), lookup() {}
+
+    bool contains(const std::string& key) const { return lookup.count(key) != 0; }
+    void pushFront(const std::string& key);
+    void erase(const std::string& key);
+    void popBack();
+    void clear() { order.clear(); lookup.clear(); }
+    size_t size() const { return order.size(); }
+    bool empty() const { return order.empty(); }
+};
+
+/**
+ * @brief Eviction Policy Interface (Strategy)
+ *
+ * LRUCache owns the slots, the key index and the free list; the policy only
+ * decides eviction order. It is told about every occupancy change through the
+ * callbacks below and keeps its bookkeeping inside the slots themselves.
+ *
+ * Call order used by LRUCache:
+ * - HIT:  onHit(idx)
+ * - MISS: onMiss(key); [selectVictim(); onEvict(victim)] if full; onInsert(idx)
+ * - clear()/replace of a key: onRemove(idx)
+ * - storage rebuilt (clear, set_capacity, policy swap): attach(slots, capacity)
+ * - storage grown in place (set_capacity, byte-budget mode): onCapacityChange(capacity)
+ * - storage shrunk (set_capacity): victims evicted as usual, onMove(from, to) for each
+ *   survivor compacted below the new capacity, then onCapacityChange(capacity)
+ * - known access sequence (playlist): onPlan(sequence), then onAdvance(i) before access i
+ */
+class EvictionPolicy {
+protected:
+    std::vector<CacheSlot>* slots;
+    size_t capacity;
+
+public:
+    EvictionPolicy() : slots(nullptr), capacity(0) {}
+    virtual ~EvictionPolicy() = default;
+
+    EvictionPolicy(const EvictionPolicy&) = delete;
+    EvictionPolicy& operator=(const EvictionPolicy&) = delete;
+
+    /**
+     * @brief Short identifier as used in dj_config.txt (e.g. "lru", "arc")
+     */
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief Bind to (possibly reallocated) slot storage; drops all tracked state
+     */
+    virtual void attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity);
+
+    /**
+     * @brief Slot storage grew in place; existing slot indices stay valid
+     */
+    virtual void onCapacityChange(size_t cache_capacity) { capacity = cache_capacity; }
+
+    /**
+     * @brief Slot from's track and metadata (prev/next, frequency, tag) now live in the empty slot to
+     * Policies that refer to slots by index repoint those references; from is left empty.
+     */
+    virtual void onMove(size_t from, size_t to) { (void)from; (void)to; }
+
+    /**
+     * @brief A lookup for key missed; called before any eviction/insert for it
+     */
+    virtual void onMiss(const std::string& key) { (void)key; }
+
+    /**
+     * @brief Slot idx was just filled (its key is slots[idx].getKey())
+     */
+    virtual void onInsert(size_t idx) = 0;
+
+    /**
+     * @brief Slot idx was accessed
+     */
+    virtual void onHit(size_t idx) = 0;
+
+    /**
+     * @brief Slot idx is being emptied without eviction semantics
+     */
+    virtual void onRemove(size_t idx) = 0;
+
+    /**
+     * @brief Choose the next slot to evict (does not remove it)
+     * @return Slot index, or CacheSlot::NIL if nothing is evictable
+     */
+    virtual size_t selectVictim() = 0;
+
+    /**
+     * @brief Slot idx (the chosen victim) is being evicted
+     */
+    virtual void onEvict(size_t idx) { onRemove(idx); }
+
+    /**
+     * @brief The future access sequence is known (e.g. a fixed playlist)
+     * Only clairvoyant policies use it; the default ignores it.
+     */
+    virtual void onPlan(const std::vector<std::string>& sequence) { (void)sequence; }
+
+    /**
+     * @brief Access number `position` of the planned sequence is about to be served
+     */
+    virtual void onAdvance(size_t position) { (void)position; }
+
+    /**
+     * @brief Would inserting key (ahead of its use) be worth evicting the current victim?
+     * Only consulted for prefetches into a full cache; the default always admits.
+     */
+    virtual bool admitPrefetch(const std::string& key) const { (void)key; return true; }
+
+    /**
+     * @brief Create a policy by name ("lru", "lfu", "clock", "arc", "2q", "belady")
+     * @return Owning wrapper, empty if the name is unknown
+     */
+    static PointerWrapper<EvictionPolicy> create(const std::string& policy_name);
+};
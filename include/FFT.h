@@ -0,0 +1,45 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief In-place radix-2 complex FFT of one fixed size (Helper)
+ *
+ * Twiddle factors and the bit-reversal permutation are computed once in the
+ * constructor, so repeated transforms (STFT frames) cost O(n log n) each with
+ * no trigonometry or allocation.
+ */
+class FFT {
+private:
+    size_t n;
+    std::vector<std::complex<double> > twiddles;  // exp(-2*pi*i*k/n), k < n/2
+    std::vector<size_t> bit_reversed;
+
+public:
+    /**
+     * @param size Transform length; must be a power of two (>= 1)
+     */
+    explicit FFT(size_t size);
+
+    size_t size() const { return n; }
+
+    /**
+     * @brief Forward transform of size() values at data
+     */
+    void forward(std::complex<double>* data) const;
+
+    /**
+     * @brief Inverse transform of size() values at data, scaled by 1/size()
+     */
+    void inverse(std::complex<double>* data) const;
+
+    /**
+     * @brief Smallest power of two >= value (1 for 0)
+     */
+    static size_t next_power_of_two(size_t value);
+
+private:
+    void transform(std::complex<double>* data, bool invert) const;
+};
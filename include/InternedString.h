@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+/**
+ * @brief Handle to a string in the process-wide intern pool (Helper)
+ *
+ * Every distinct string is stored once; an InternedString is a 4-byte id, so
+ * copies cost nothing and equality is an integer compare. Pooled strings are
+ * never freed or moved, so str() references stay valid for the life of the
+ * process and accessors can return them without copying.
+ * Interning and find() take the pool's lock (DJLibraryService's build
+ * workers intern concurrently); str() and comparisons do not.
+ */
+class InternedString {
+private:
+    uint32_t id;
+
+public:
+    struct PoolStats {
+        size_t strings;  // Distinct strings pooled (including "")
+        size_t bytes;    // Pool memory: string objects, their heap buffers and the lookup index
+    };
+
+    /**
+     * The empty string (no pool access)
+     */
+    InternedString() : id(0) {}
+
+    /**
+     * Intern value, adding it to the pool on first sight
+     */
+    explicit InternedString(const std::string& value);
+
+    const std::string& str() const;
+    operator const std::string&() const { return str(); }
+
+    uint32_t get_id() const { return id; }
+
+    bool operator==(const InternedString& other) const { return id == other.id; }
+    bool operator!=(const InternedString& other) const { return id != other.id; }
+
+    /**
+     * @brief Look value up without adding it
+     * @return false if value was never interned (out is left unchanged)
+     */
+    static bool find(const std::string& value, InternedString& out);
+
+    static PoolStats pool_stats();
+};
+
+std::ostream& operator<<(std::ostream& out, const InternedString& value);
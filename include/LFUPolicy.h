@@ -0,0 +1,31 @@
+#pragma once
+
+#include "EvictionPolicy.h"
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * @brief Least Frequently Used eviction (O(1) frequency buckets)
+ *
+ * Slots are grouped in one recency list per access count. The victim is the
+ * least recently used slot of the lowest non-empty count, so ties between
+ * equally popular tracks fall back to LRU.
+ */
+class LFUPolicy : public EvictionPolicy {
+private:
+    std::unordered_map<uint64_t, SlotList> buckets;  // access count -> slots
+    uint64_t min_frequency;                          // 0 = unknown, recomputed lazily
+
+    void detach(size_t idx);
+
+public:
+    LFUPolicy() : buckets(), min_frequency(0) {}
+
+    const char* name() const override { return "lfu"; }
+    void attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) override;
+    void onInsert(size_t idx) override;
+    void onHit(size_t idx) override;
+    void onRemove(size_t idx) override;
+    void onMove(size_t from, size_t to) override;
+    size_t selectVictim() override;
+};
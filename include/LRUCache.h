@@ -2,11 +2,13 @@
 
 #include "CacheSlot.h"
 #include "AudioTrack.h"
+#include "EvictionPolicy.h"
 #include "PointerWrapper.h"
 #include <vector>
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <unordered_map>
 
 /**
  * @brief LRU Cache Implementation
@@ -19,12 +21,33 @@
  * - Used by DJControllerService with fixed capacity in this assignment.
  * - get() marks entries MRU by updating their access time.
  * - put() inserts as MRU and evicts true LRU when full.
+ *
+ * Implementation: a hash index maps each key to its slot and empty slots form
+ * a free list through CacheSlot::next, so lookups and inserts never scan.
+ * Keys are interned titles indexed by their integer id, so the InternedString
+ * overloads neither hash nor copy a string; the std::string overloads look
+ * the title up in the intern pool first.
+ * Eviction order is delegated to a pluggable EvictionPolicy (LRU by default;
+ * LFU, CLOCK, ARC and 2Q are available through set_policy()). The policy keeps
+ * its lists intrusively in the slots. With LRU, every operation is O(1);
+ * "LRU" in method names below means "the policy's victim".
+ *
+ * With a byte budget set (set_byte_budget), capacity is measured in track
+ * memory instead of slots: put() evicts victims until the new track fits,
+ * and slot storage grows in place (doubling) whenever every slot is taken.
  */
 class LRUCache {
 private:
     std::vector<CacheSlot> slots;
     size_t max_size;
     uint64_t access_counter;
+    std::unordered_map<uint32_t, size_t> index;     // Interned key id -> slot index
+    size_t free_head;   // First empty slot, or CacheSlot::NIL
+    size_t used;        // Number of occupied slots
+    size_t max_bytes;   // Byte budget, or 0 to limit by slot count
+    size_t used_bytes;  // Sum of the cached tracks' memory footprints
+    size_t peak_bytes;  // Highest used_bytes seen
+    PointerWrapper<EvictionPolicy> policy;          // Decides eviction order
 
 public:
     /**
@@ -32,6 +55,10 @@ public:
      * @param capacity Maximum number of tracks to cache
      */
     explicit LRUCache(size_t capacity);
+
+    // The policy holds a pointer to this cache's slot storage; never copy or move
+    LRUCache(const LRUCache&) = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
     
     /**
      * @brief Check if cache contains a track
@@ -39,6 +66,11 @@ public:
      * @return true if track is in cache
      */
     bool contains(const std::string& track_id) const;
+
+    /**
+     * @brief contains() by interned title: one integer hash, no string work
+     */
+    bool contains(InternedString track_id) const;
     
     /**
      * @brief Get a track from cache (updates LRU order)
@@ -49,6 +81,24 @@ public:
      * "most recently used" position in LRU algorithm.
      */
     AudioTrack* get(const std::string& track_id);
+
+    /**
+     * @brief get() by interned title (AudioTrack::get_title_id())
+     */
+    AudioTrack* get(InternedString track_id);
+
+    /**
+     * @brief Get a track without counting an access
+     * The policy sees no hit and the access time is unchanged, so a track
+     * already touched by get() or put() is not promoted a second time.
+     * @return Raw pointer to track, or nullptr if not found
+     */
+    AudioTrack* peek(const std::string& track_id) const;
+
+    /**
+     * @brief peek() by interned title
+     */
+    AudioTrack* peek(InternedString track_id) const;
     
     /**
      * @brief Put a track into cache (handles eviction if full)
@@ -61,7 +111,7 @@ public:
     bool put(PointerWrapper<AudioTrack> track);
     
     /**
-     * @brief Manually evict the least recently used track
+     * @brief Manually evict the policy's victim (the LRU track under LRU)
      * @return true if a track was evicted
      */
     bool evictLRU();
@@ -92,10 +142,81 @@ public:
      */
     void displayStatus() const;
     /**
-     * @brief Update LRU Cache capacity
-     * This method should be used only once.
+     * @brief Change the slot count at any time, keeping the policy's state
+     * Growing keeps every entry in place and costs amortized O(1) per new
+     * slot. Shrinking evicts in policy order until the survivors fit, then
+     * moves survivors stored above the new capacity into free lower slots.
+     * @return Keys evicted to fit, in eviction order
+     */
+    std::vector<std::string> set_capacity(size_t capacity);
+
+    /**
+     * @brief Replace the eviction policy
+     * @param new_policy Policy to use (transfers ownership); ignored if empty
+     * Cached tracks are kept and handed to the new policy oldest-first.
+     */
+    void set_policy(PointerWrapper<EvictionPolicy> new_policy);
+
+    /**
+     * @brief Name of the active eviction policy (e.g. "lru")
+     */
+    const char* policy_name() const { return policy->name(); }
+
+    /**
+     * @brief Limit the cache by track memory instead of slot count
+     * @param bytes Budget in bytes; 0 returns to slot counting
+     * Entries are evicted in policy order until the cache fits. A single
+     * track larger than the whole budget is still cached, alone.
+     */
+    void set_byte_budget(size_t bytes);
+
+    /**
+     * @brief Byte budget, or 0 when limited by slot count
+     */
+    size_t byte_budget() const { return max_bytes; }
+
+    /**
+     * @brief Memory currently held by cached tracks
+     */
+    size_t memory_used() const { return used_bytes; }
+
+    /**
+     * @brief Highest memory_used() since construction
+     */
+    size_t memory_peak() const { return peak_bytes; }
+
+    /**
+     * @brief Key put(incoming) would evict first, without evicting it
+     * @return nullptr if incoming is already cached or fits without an eviction
+     * CLOCK may advance its hand (clearing reference bits) to find the victim.
+     */
+    const std::string* victimFor(const AudioTrack& incoming) const;
+
+    /**
+     * @brief victimFor() reporting the victim's interned key
+     * @return false (victim untouched) when there is no victim
+     */
+    bool victimFor(const AudioTrack& incoming, InternedString& victim) const;
+
+    /**
+     * @brief Announce the upcoming access sequence (forwarded to the policy)
+     * @param sequence Keys in the order they will be requested
+     */
+    void plan(const std::vector<std::string>& sequence) { policy->onPlan(sequence); }
+
+    /**
+     * @brief Mark access number `position` of the planned sequence as current
+     */
+    void advance(size_t position) { policy->onAdvance(position); }
+
+    /**
+     * @brief Should a prefetch of this key be inserted now?
+     * @return true if there is a free slot or the policy accepts displacing its victim
      */
-    void set_capacity(size_t capacity);
+    bool admitsPrefetch(const std::string& track_id) const {
+        if (max_bytes > 0) return used_bytes < max_bytes || policy->admitPrefetch(track_id);
+        return free_head != CacheSlot::NIL || policy->admitPrefetch(track_id);
+    }
 private:
     /**
      * @brief Find slot containing specific track
@@ -103,16 +224,62 @@ private:
      * @return Slot index, or max_size if not found
      */
     size_t findSlot(const std::string& track_id) const;
+    size_t findSlot(InternedString track_id) const;
     
     /**
-     * @brief Find the least recently used slot
-     * @return Slot index of LRU entry
+     * @brief Find the slot the policy would evict next
+     * @return Slot index of the victim, or max_size if the cache is empty
      */
     size_t findLRUSlot() const;
+
+    /**
+     * @brief Slot put(incoming) would evict first, or max_size if none
+     */
+    size_t findVictimSlot(const AudioTrack& incoming) const;
     
     /**
      * @brief Find first empty slot
      * @return Slot index, or max_size if cache is full
      */
     size_t findEmptySlot() const;
+
+    /**
+     * @brief Fill an empty slot and register it with the index and the policy
+     */
+    size_t storeInFreeSlot(PointerWrapper<AudioTrack> track, uint64_t access_time);
+
+    /**
+     * @brief Rebuild slot storage at the given capacity, keeping the most recent entries
+     */
+    void rebuild(size_t capacity);
+
+    /**
+     * @brief Grow slot storage in place; occupied slots keep their indices
+     */
+    void grow(size_t capacity);
+
+    /**
+     * @brief Evict to fit, compact survivors below capacity and truncate storage
+     */
+    void shrink(size_t capacity, std::vector<std::string>& evicted);
+
+    /**
+     * @brief Empty an occupied slot with eviction semantics (the policy sees onEvict)
+     */
+    void evictSlot(size_t victim);
+
+    /**
+     * @brief Move an entry and its policy metadata into the empty slot to
+     */
+    void moveSlot(size_t from, size_t to);
+
+    /**
+     * @brief Return a slot to the free list
+     */
+    void pushFree(size_t idx);
+
+    /**
+     * @brief Rebuild the free list from every slot in [from, slots.size())
+     */
+    void resetFreeList(size_t from);
 };
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "EvictionPolicy.h"
+
+/**
+ * @brief Least Recently Used eviction
+ *
+ * One recency list: hits and inserts move to the head, the tail is evicted.
+ * This is the controller's default policy.
+ */
+class LRUPolicy : public EvictionPolicy {
+private:
+    SlotList recency;
+
+public:
+    LRUPolicy() : recency() {}
+
+    const char* name() const override { return "lru"; }
+    void attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) override;
+    void onInsert(size_t idx) override;
+    void onHit(size_t idx) override;
+    void onRemove(size_t idx) override;
+    void onMove(size_t from, size_t to) override;
+    size_t selectVictim() override;
+};
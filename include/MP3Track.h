@@ -26,32 +26,37 @@ public:
     MP3Track(const std::string& title, const std::vector<std::string>& artists, 
              int duration, int bpm, int bitrate, bool has_tags = true);
 
-    // ========== TODO: IMPLEMENT VIRTUAL FUNCTIONS ==========
+    // ========== VIRTUAL FUNCTION IMPLEMENTATIONS ==========
 
     /**
-     * TODO: Implement load function for MP3 files
-     * HINT: Print loading message specific to MP3 format
+     * Simulate loading: bitrate, ID3 tag processing and frame decoding
      */
     void load() override;
 
     /**
-     * TODO: Implement beat grid analysis for MP3
-     * HINT: MP3 analysis might be less precise than WAV
+     * Report the estimated beats and the compression precision factor (bitrate / 320)
      */
     void analyze_beatgrid() override;
 
     /**
-     * TODO: Implement quality score calculation
-     * HINT: Use bitrate to determine quality (higher bitrate = better quality)
+     * Quality 0-100 from the bitrate (320 kbps = 100), +5 with ID3 tags, -10 under 128 kbps
      */
     double get_quality_score() const override;
 
+    TrackFormat get_format() const override { return TrackFormat::MP3; }
+
     /**
-     * TODO: Implement clone function
-     * HINT: Return a unique_ptr to a new MP3Track with same properties
+     * Polymorphic copy (shares waveform and analysis with this track)
      */
     PointerWrapper<AudioTrack> clone() const override;
 
+    /**
+     * Encoded stream: duration x bitrate (frames are decoded as they play)
+     */
+    size_t audio_bytes() const override;
+
+    size_t memory_footprint() const override { return sizeof(MP3Track) + audio_bytes() + heap_footprint(); }
+
     // Getters
     int get_bitrate() const { return bitrate; }
     bool has_tags() const { return has_id3_tags; }
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief LRU miss-ratio curve from a single pass over an access trace
+ *
+ * Mattson's stack algorithm: an access hits in an LRU cache of capacity c
+ * exactly when its reuse (stack) distance - the number of distinct keys
+ * touched since the previous access to the same key - is below c. One pass
+ * builds the histogram of reuse distances, after which the hit count for
+ * every capacity is a prefix sum.
+ *
+ * Distances are counted with a Fenwick tree over trace positions that marks
+ * only the latest access of each key, so the pass is O(n log n) and scales
+ * to million-entry traces. The curve is exact for LRU; other policies are
+ * not stack algorithms and must be simulated.
+ */
+class MissRatioCurve {
+private:
+    std::vector<size_t> cumulative_hits;  // [c] = hits with capacity c (c = 0..distinct)
+    size_t total_accesses;
+    size_t distinct_keys;
+
+public:
+    /**
+     * @brief Analyze a trace
+     * @param trace Keys in access order (e.g. track titles of a playlist)
+     */
+    explicit MissRatioCurve(const std::vector<std::string>& trace);
+
+    size_t accesses() const { return total_accesses; }
+
+    /**
+     * @brief Number of distinct keys; capacities beyond it gain nothing
+     */
+    size_t distinct() const { return distinct_keys; }
+
+    /**
+     * @brief Hits an LRU cache of this capacity would score on the trace
+     */
+    size_t hits(size_t capacity) const;
+
+    /**
+     * @brief Hit rate in [0, 1] for an LRU cache of this capacity
+     */
+    double hit_rate(size_t capacity) const;
+};
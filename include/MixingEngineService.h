@@ -19,6 +19,10 @@ public:
     MixingEngineService();
     ~MixingEngineService();
 
+    // Decks own raw track pointers; copying would double-delete them
+    MixingEngineService(const MixingEngineService&) = delete;
+    MixingEngineService& operator=(const MixingEngineService&) = delete;
+
     /** Contract: Load a track to the next deck per instant-transition policy
      * - @param track: reference to a cached track to be cloned for the mixer
      * - @return: index of the deck the track was loaded to (0 or 1), or -1 on failure.
@@ -30,6 +34,14 @@ public:
     // Display deck status
     void displayDeckStatus() const;
 
+    /**
+     * @brief Library id of the track on a deck (deck clones keep it)
+     * @return 0 for an empty deck, a non-library track or a deck index past 1
+     */
+    TrackId getDeckTrackId(size_t deck) const {
+        return deck < 2 && decks[deck] ? decks[deck]->get_id() : 0;
+    }
+
     /**
      * Contract: Determine if decks A and the given track can be mixed
      * @return true if mixable by BPM/key criteria; false otherwise
@@ -2,38 +2,150 @@
 #define PLAYLIST_H
 
 #include "AudioTrack.h"
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /**
- * ⚠️  WARNING: THIS CLASS HAS INTENTIONAL MEMORY LEAKS! ⚠️
- * 
- * This is Phase 1 of the assignment - students must identify and fix all memory leaks.
- * @todo Implement proper memory management to prevent leaks.
- * @note In phase 4, the library service should provide canonical ownership semantics
- * for tracks referenced by playlists. Fixes in earlier phases should ensure
- * clear ownership and safe iteration without leaks.
+ * Node of a Playlist's doubly-linked list, allocated from the playlist's
+ * node pool; whether track is owned depends on the playlist (see Playlist)
  */
-
 struct PlaylistNode {
-    AudioTrack* track; 
+    AudioTrack* track;   // Deleted by the playlist if it owns its tracks; nullptr while on the free list
+    PlaylistNode* prev;
     PlaylistNode* next;
+    int counted_bpm;           // BPM and tier PlaylistStats counted at insertion; the
+    QualityTier counted_tier;  // track's own may change later (set_bpm, shared instances)
+
+    PlaylistNode() : track(nullptr), prev(nullptr), next(nullptr), counted_bpm(0), counted_tier(QualityTier::Low) {}
 
-    PlaylistNode(AudioTrack* t) : track(t), next(nullptr) {}
-    ~PlaylistNode() {delete track;}
+    PlaylistNode(const PlaylistNode&) = delete;
+    PlaylistNode& operator=(const PlaylistNode&) = delete;
 };
 
+/**
+ * Running aggregates over a playlist's tracks, updated on every add and
+ * remove so each query is O(1) (the UI polls them during a live set)
+ */
+class PlaylistStats {
+private:
+    long long total_duration;
+    long long bpm_sum;
+    size_t tracks;
+    std::map<int, size_t> bpm_counts;   // BPM -> tracks; its ends are the min and max
+    size_t format_counts[2];            // Indexed by TrackFormat
+    size_t tier_counts[4];              // Indexed by QualityTier
+
+public:
+    PlaylistStats();
+
+    /**
+     * Count node's track, recording the BPM and tier counted in the node
+     */
+    void add(PlaylistNode& node);
+
+    /**
+     * Uncount node's track by the values add() recorded, not its current ones
+     */
+    void remove(const PlaylistNode& node);
+    void clear();
+
+    long long get_total_duration() const { return total_duration; }
+
+    /**
+     * Lowest, highest and mean BPM (0 for an empty playlist)
+     */
+    int get_min_bpm() const { return bpm_counts.empty() ? 0 : bpm_counts.begin()->first; }
+    int get_max_bpm() const { return bpm_counts.empty() ? 0 : bpm_counts.rbegin()->first; }
+    double get_mean_bpm() const { return tracks ? static_cast<double>(bpm_sum) / tracks : 0.0; }
+
+    /**
+     * Tracks per BPM value, ascending
+     */
+    const std::map<int, size_t>& get_bpm_histogram() const { return bpm_counts; }
+
+    size_t get_format_count(TrackFormat format) const { return format_counts[static_cast<size_t>(format)]; }
+    size_t get_tier_count(QualityTier tier) const { return tier_counts[static_cast<size_t>(tier)]; }
+};
+
+/**
+ * Nodes are carved from chunks owned by the playlist (8 nodes, doubling up to
+ * 4096 per chunk) and recycled through a free list, so a playlist built in
+ * one go sits in a few contiguous blocks instead of one allocation per track.
+ * The list is doubly linked with head and tail pointers: add_track and
+ * append_track are O(1), and so is removal through the PlaylistNode* handle
+ * either returns. Iterate with begin()/end() (or range-for) rather than
+ * copying through getTracks().
+ *
+ * A playlist either owns its tracks (the default: removal and destruction
+ * delete them, copies clone them) or borrows them from an owner that
+ * outlives it, such as DJLibraryService's library. A borrowing playlist's
+ * nodes are plain handles, so one track can appear any number of times, in
+ * any number of playlists, without being copied.
+ */
 class Playlist {
+public:
+    /**
+     * Forward iterator over the playlist's tracks, in list order
+     */
+    class const_iterator {
+    private:
+        const PlaylistNode* node;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef AudioTrack* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef AudioTrack* const* pointer;
+        typedef AudioTrack* const& reference;
+
+        explicit const_iterator(const PlaylistNode* start = nullptr) : node(start) {}
+
+        reference operator*() const { return node->track; }
+        pointer operator->() const { return &node->track; }
+        const_iterator& operator++() { node = node->next; return *this; }
+        const_iterator operator++(int) { const_iterator before(*this); node = node->next; return before; }
+        bool operator==(const const_iterator& other) const { return node == other.node; }
+        bool operator!=(const const_iterator& other) const { return node != other.node; }
+
+        /**
+         * The node under the iterator, usable with remove_track
+         */
+        PlaylistNode* handle() const { return const_cast<PlaylistNode*>(node); }
+    };
+
 private:
+    // Title index entry: the first node in list order with that title, and
+    // how many nodes share it (so removal knows whether to look for the next)
+    struct TitleEntry {
+        PlaylistNode* first;
+        size_t count;
+    };
+
     PlaylistNode* head;
+    PlaylistNode* tail;
     std::string playlist_name;
     int track_count;
+    bool owns_tracks;
+    std::unordered_map<std::string, TitleEntry> title_index;  // title -> first matching node
+    PlaylistStats stats;
+
+    // Node pool: every node lives in one of chunks; freed nodes are chained through next
+    std::vector<std::unique_ptr<PlaylistNode[]>> chunks;
+    size_t chunk_capacity;      // Nodes in the last chunk
+    size_t chunk_used;          // Nodes handed out from the last chunk
+    PlaylistNode* free_nodes;
 
 public:
     /**
      * Constructor
+     * @param owns_tracks false to hold handles to tracks owned elsewhere
      */
-    Playlist(const std::string& name="");
+    Playlist(const std::string& name="", bool owns_tracks=true);
 
     /**
      * Destructor
@@ -41,10 +153,39 @@ public:
     ~Playlist();
 
     /**
-     * Add a track to the playlist
+     * Copy constructor - preserves order; deep copies every track through
+     * clone() if other owns its tracks, otherwise shares the handles
+     */
+    Playlist(const Playlist& other);
+
+    /**
+     * Copy assignment (copy-and-swap)
+     */
+    Playlist& operator=(const Playlist& other);
+
+    /**
+     * Move constructor - steals the node chain and its pool
+     */
+    Playlist(Playlist&& other) noexcept;
+
+    /**
+     * Move assignment - releases current nodes, then steals the node chain and its pool
+     */
+    Playlist& operator=(Playlist&& other) noexcept;
+
+    /**
+     * Add a track to the front of the playlist
+     * @param track Pointer to AudioTrack to add
+     * @return The track's node, a handle for remove_track (nullptr for a null track)
+     */
+    PlaylistNode* add_track(AudioTrack* track);
+
+    /**
+     * Add a track to the end of the playlist, keeping insertion order
      * @param track Pointer to AudioTrack to add
+     * @return The track's node, a handle for remove_track (nullptr for a null track)
      */
-    void add_track(AudioTrack* track);
+    PlaylistNode* append_track(AudioTrack* track);
 
     /**
      * Remove a track by title
@@ -52,6 +193,12 @@ public:
      */
     void remove_track(const std::string& title);
 
+    /**
+     * Remove the track at node, a handle returned by add_track/append_track or
+     * const_iterator::handle() of this playlist
+     */
+    void remove_track(PlaylistNode* node);
+
     /**
      * Display all tracks in the playlist
      */
@@ -62,12 +209,13 @@ public:
      * @return Number of tracks in the playlist
      */
     int get_track_count() const { return track_count; }
+    bool get_owns_tracks() const { return owns_tracks; }
     const std::string& get_name() const { return playlist_name; }
 
     /**
      * @param title Title of the track to find
-     * @brief Find a track by title
-     * @return Pointer to the found track, or nullptr if not found
+     * @brief Find a track by title (O(1) through the title index)
+     * @return Pointer to the first track in list order with that title, or nullptr if not found
      */
     AudioTrack* find_track(const std::string& title) const;
 
@@ -77,15 +225,48 @@ public:
     bool is_empty() const { return head == nullptr; }
 
     /**
-     * Calculate total duration of all tracks
+     * Total duration of all tracks, in seconds (O(1), from the running aggregates)
+     */
+    int get_total_duration() const { return static_cast<int>(stats.get_total_duration()); }
+
+    /**
+     * Running aggregates: duration, BPM range, mean and histogram, format and quality tier counts
      */
-    int get_total_duration() const;
+    const PlaylistStats& get_stats() const { return stats; }
 
     /**
      * Get all tracks as a vector
      */
     std::vector<AudioTrack*> getTracks() const;
 
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(); }
+
+private:
+    /**
+     * Delete every node (and its track, if owned)
+     */
+    void clear_nodes();
+
+    /**
+     * Record node in the title index; first marks it as the earliest in list order
+     */
+    void index_node(PlaylistNode* node, bool first);
+
+    /**
+     * Drop node from the title index, promoting the next node with its title
+     */
+    void unindex_node(PlaylistNode* node);
+
+    /**
+     * Take a node from the free list or the pool, holding track
+     */
+    PlaylistNode* acquire_node(AudioTrack* track);
+
+    /**
+     * Unlink node, delete its track if owned and return it to the free list
+     */
+    void release_node(PlaylistNode* node);
 };
 
 
@@ -3,6 +3,7 @@
 
 #include <utility>
 #include <iostream>
+#include <stdexcept>
 
 /**
  * PointerWrapper - A template class that wraps a raw pointer
@@ -32,12 +33,11 @@ public:
     explicit PointerWrapper(T* p) : ptr(p) {}
 
     /**
-     * TODO: Implement destructor
-     * HINT: What should happen to the wrapped pointer when the wrapper is destroyed?
-     * Think about ownership and resource management.
-     * Is the default destructor sufficient here?
+     * Destructor - deletes the owned object (if any)
      */
-    ~PointerWrapper() =default;
+    ~PointerWrapper() {
+        delete ptr;
+    }
 
     // ========== COPY OPERATIONS (DELETED) ==========
 
@@ -53,83 +53,88 @@ public:
      */
     PointerWrapper& operator=(const PointerWrapper& other) = delete;
 
-    // ========== MOVE OPERATIONS (STUDENTS IMPLEMENT) ==========
+    // ========== MOVE OPERATIONS ==========
 
     /**
-     * TODO: Implement move constructor
-     * HINT: How should ownership transfer from one wrapper to another?
-     * What should happen to the source wrapper after the move?
+     * Move constructor - takes ownership; the source is left empty
      */
-    PointerWrapper(PointerWrapper&& other) noexcept {}
+    PointerWrapper(PointerWrapper&& other) noexcept : ptr(other.ptr) {
+        other.ptr = nullptr;
+    }
 
     /**
-     * TODO: Implement move assignment operator
-     * HINT: Handle cleanup of current resource and ownership transfer
-     * Don't forget about self-assignment!
+     * Move assignment - deletes the current object, then takes ownership
+     * from the source (left empty); self-assignment is a no-op
      */
     PointerWrapper& operator=(PointerWrapper&& other) noexcept {
+        if (this != &other) {
+            delete ptr;
+            ptr = other.ptr;
+            other.ptr = nullptr;
+        }
         return *this;
     }
 
     // ========== ACCESS OPERATIONS ==========
 
     /**
-     * TODO: Implement dereference operator
-     * HINT: How do you access the object that the wrapper points to? Is this operation implementation complete?
+     * Dereference the wrapped object
      * @throws std::runtime_error if ptr is null
      */
-
     T& operator*() const {
+        if (!ptr) {
+            throw std::runtime_error("PointerWrapper: dereferencing null pointer");
+        }
         return *ptr;
     };
 
     /**
-     * TODO: Implement arrow operator
-     * HINT: How do you access members of the wrapped object?
-     * What safety checks should you perform?
+     * Member access on the wrapped object
+     * @throws std::runtime_error if ptr is null
      */
     T* operator->() const {
-        return nullptr;
+        if (!ptr) {
+            throw std::runtime_error("PointerWrapper: member access through null pointer");
+        }
+        return ptr;
     }
 
     /**
-     * TODO: Implement get() function
-     * HINT: Sometimes you need access to the raw pointer without changing ownership
-     * What should this function return?
-     * @throws std::runtime_error if ptr is null
+     * Raw pointer without transferring ownership (nullptr when empty)
      */
     T* get() const {
-        return nullptr; // Placeholder
+        return ptr;
     }
 
     // ========== OWNERSHIP MANAGEMENT ==========
 
     /**
-     * TODO: Implement release() function
-     * HINT: What does "release" mean in terms of ownership?
-     * Should the wrapper still own the pointer after calling release()?
+     * Give up ownership: returns the pointer and leaves the wrapper empty
      */
     T* release() {
-        return nullptr;
+        T* released = ptr;
+        ptr = nullptr;
+        return released;
     }
 
     /**
-     * TODO: Implement reset() function
-     * HINT: How do you replace the currently wrapped pointer?
-     * What should happen to the old pointer?
+     * Replace the wrapped pointer, deleting the old object (unless it is new_ptr)
      */
     void reset(T* new_ptr = nullptr) {
+        if (ptr != new_ptr) {
+            delete ptr;
+            ptr = new_ptr;
+        }
     }
 
     // ========== UTILITY FUNCTIONS ==========
 
     /**
-     * TODO: Implement boolean conversion operator
-     * HINT: When should a wrapper be considered "true" or "false"?
-     * Why might the explicit keyword be important here?
+     * True when the wrapper holds an object; explicit, so wrappers do not
+     * convert to bool (or int) implicitly
      */
     explicit operator bool() const {
-        return false; //placeholder
+        return ptr != nullptr;
     }
 
     /**
@@ -154,15 +159,11 @@ PointerWrapper<T> make_pointer_wrapper(Args&&... args) {
 }
 
 /**
- * TODO: Implement swap for PointerWrapper
- * HINT: How can you swap two wrapper objects?
- * Why might this be useful?
+ * Non-member swap, found by argument-dependent lookup (e.g. from std algorithms)
  */
 template<typename T>
 void swap(PointerWrapper<T>& lhs, PointerWrapper<T>& rhs) noexcept {
-    // TODO: Implement global swap function
-    // HINT: You can use the member swap function
-    //your code here...
+    lhs.swap(rhs);
 }
 
 #endif // POINTERWRAPPER_H
\ No newline at end of file
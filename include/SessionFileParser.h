@@ -37,6 +37,18 @@ struct SessionConfig {
     
     // Cache settings
     int controller_cache_size;
+    size_t controller_cache_bytes;  // Byte budget (0 = limit by controller_cache_size slots)
+    size_t controller_cache_ceiling; // Adaptive slot count under this much track memory (0 = fixed)
+    std::string cache_policy;    // lru, lfu, clock, arc, 2q or belady
+    std::string cache_admission; // none or tinylfu
+    int prefetch_lookahead;      // Upcoming tracks to cache ahead of demand (0 = off)
+    
+    // Waveform settings
+    std::string waveform_format; // float64, float32, int16 or mulaw8 (empty = build default)
+    
+    // Library build settings
+    int library_build_threads;   // buildLibrary workers (1 = serial, 0 = one per hardware thread)
+    bool library_build_log;      // Print a line per constructed track
     
     // Mixing settings
     int default_crossfade_time;
@@ -50,6 +62,14 @@ struct SessionConfig {
           version(""), 
           library_tracks(), 
           controller_cache_size(8), 
+          controller_cache_bytes(0), 
+          controller_cache_ceiling(0), 
+          cache_policy("lru"), 
+          cache_admission("none"), 
+          prefetch_lookahead(0), 
+          waveform_format(""), 
+          library_build_threads(1), 
+          library_build_log(true), 
           default_crossfade_time(5), 
           bpm_tolerance(10), 
           auto_sync(true), 
@@ -99,6 +119,14 @@ public:
      * library_track_1=MP3,title,{artist1;artist2;},duration,bpm,bitrate,has_tags
      * library_track_2=WAV,title,{artist1;artist2;},duration,bpm,sample_rate,bit_depth
      * controller_cache_size=8
+     * controller_cache_bytes=512M   (optional; K/M/G suffixes are powers of 1024)
+     * controller_cache_ceiling=2G   (optional; adaptive slot count)
+     * cache_policy=lru
+     * cache_admission=tinylfu
+     * prefetch_lookahead=2
+     * waveform_format=int16
+     * library_build_threads=4
+     * library_build_log=false
      * bpm_tolerance=10
      * auto_sync=true
      * playlistname=1,2,3
@@ -155,6 +183,14 @@ private:
      */
     static bool parse_bool(const std::string& str);
     
+    /**
+     * @brief Parse a byte count with optional K, M or G suffix (e.g. "512M")
+     * @param str String to parse
+     * @param bytes Output byte count
+     * @return true if parsing successful
+     */
+    static bool parse_byte_size(const std::string& str, size_t& bytes);
+    
     /**
      * @brief Check if line is a comment (starts with #)
      * @param line Line to check
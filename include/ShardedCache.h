@@ -0,0 +1,102 @@
+#pragma once
+
+#include "AudioTrack.h"
+#include "PointerWrapper.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Thread-safe track cache shared by several controllers (sessions)
+ *
+ * Keys are hashed to one of a power-of-two number of shards; each shard has
+ * its own reader-writer lock, key index and fixed slot array, and the
+ * capacity is split evenly between them. Lookups take the shard's read lock
+ * only, so readers of a shard never wait for each other; inserts and
+ * evictions take its write lock.
+ *
+ * Eviction is CLOCK (second chance) per shard, an approximation of LRU:
+ * a hit sets the entry's atomic reference bit (a relaxed store, skipped when
+ * the bit is already set), so recency bookkeeping needs no write lock and no
+ * list reordering. Inserts set the bit too, as ClockPolicy does.
+ *
+ * Tracks are handed out as shared_ptr: a track evicted while another thread
+ * still uses it is deleted when the last holder lets go. Load and analyse a
+ * track before put(): its lazily built state is not itself synchronised.
+ */
+class ShardedCache {
+public:
+    struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t inserts;
+        uint64_t evictions;
+        uint64_t lock_acquisitions;  // Read and write locks taken
+        uint64_t lock_contended;     // ... of which had to wait for another thread
+    };
+
+    /**
+     * @param capacity Total tracks held across all shards
+     * @param shards Shard count, rounded up to a power of two (0 = 4 per
+     *        hardware thread); never more shards than capacity
+     */
+    explicit ShardedCache(size_t capacity, size_t shards = 0);
+    ~ShardedCache();
+
+    ShardedCache(const ShardedCache&) = delete;
+    ShardedCache& operator=(const ShardedCache&) = delete;
+
+    /**
+     * @brief Look a track up and mark it referenced
+     * @return The cached track, or empty on a miss
+     */
+    std::shared_ptr<AudioTrack> get(const std::string& track_id);
+
+    /**
+     * @brief get() without counting a hit or miss or marking the track referenced
+     */
+    std::shared_ptr<AudioTrack> peek(const std::string& track_id) const;
+
+    /**
+     * @brief Check for a track without counting a hit or marking it referenced
+     */
+    bool contains(const std::string& track_id) const;
+
+    /**
+     * @brief Cache a track under its title (transfers ownership)
+     * A track already cached under that title is replaced.
+     * @return true if another track was evicted to make room
+     */
+    bool put(PointerWrapper<AudioTrack> track);
+
+    /**
+     * @brief Drop every entry (tracks still held elsewhere stay alive)
+     */
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const { return total_capacity; }
+    size_t shard_count() const { return shard_total; }
+
+    /**
+     * @brief Counters summed over all shards, or for one shard
+     */
+    Stats stats() const;
+    Stats shard_stats(size_t shard) const;
+
+    /**
+     * @brief Print occupancy and counters per shard
+     */
+    void displayStatus() const;
+
+private:
+    struct Shard;
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shard_total;
+    size_t shard_mask;
+    size_t total_capacity;
+
+    Shard& shard_for(const std::string& track_id) const;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "InternedString.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief TinyLFU cache admission filter
+ *
+ * Estimates how often each key was requested recently with a count-min
+ * sketch: 4 rows of 4-bit counters, packed 16 to a 64-bit word. A key maps to
+ * one counter per row and its estimate is the smallest of them, so hash
+ * collisions can only overestimate. Increments are conservative (only the
+ * counters equal to the current minimum move), which keeps that error small.
+ *
+ * Aging: after sample_size() recorded accesses every counter is halved, so
+ * the estimate follows the recent past instead of all history.
+ *
+ * The cache asks admit(candidate, victim) before a full cache evicts: the
+ * newcomer is refused if the track it would displace was requested more
+ * often, so one-off tracks no longer push out repeated ones.
+ *
+ * Keys are interned strings and only their 4-byte id is hashed. The
+ * std::string overloads resolve the string in the intern pool and delegate,
+ * so a title maps to the same counters whichever form a caller uses.
+ */
+class TinyLFU {
+private:
+    static const size_t ROWS = 4;
+
+    std::vector<uint64_t> table;  // ROWS rows of row_words words each
+    size_t row_words;
+    size_t counter_mask;          // Counters per row - 1 (a power of two)
+    size_t sample;                // Accesses between agings
+    size_t recorded;              // Accesses since the last aging
+    size_t agings;
+
+    // Counter position of a key in each row
+    void positions(uint64_t hash, size_t (&out)[ROWS]) const;
+    void record_positions(const size_t (&position)[ROWS]);
+    unsigned estimate_positions(const size_t (&position)[ROWS]) const;
+    unsigned counter(size_t row, size_t position) const;
+    static size_t counters_for(size_t entries);
+
+public:
+    /**
+     * @param expected_entries Cache capacity in tracks; sizes the sketch
+     *        (at least 2 counters per entry) and the aging sample (10 per entry)
+     */
+    explicit TinyLFU(size_t expected_entries);
+
+    /**
+     * @brief Count one access to key
+     */
+    void record(const std::string& key) { record(InternedString(key)); }
+    void record(InternedString key);
+
+    /**
+     * @brief Estimated recent accesses of key (0..15)
+     */
+    unsigned estimate(const std::string& key) const;  // 0 for a string never interned
+    unsigned estimate(InternedString key) const;
+
+    /**
+     * @brief Should candidate replace victim in the cache?
+     * @return false only if victim's estimate is higher; ties admit, so among
+     *         equally rare tracks the cache keeps its own recency order
+     */
+    bool admit(const std::string& candidate, const std::string& victim) const {
+        return estimate(candidate) >= estimate(victim);
+    }
+    bool admit(InternedString candidate, InternedString victim) const {
+        return estimate(candidate) >= estimate(victim);
+    }
+
+    /**
+     * @brief Re-size for a new cache capacity, keeping the counts
+     * The aging sample becomes 10 per entry. When the row width changes,
+     * counters are duplicated (growing) or folded by maximum (shrinking), so
+     * no estimate drops; a fold can only overestimate, like a collision.
+     */
+    void resize(size_t expected_entries);
+
+    /**
+     * @brief Forget every count
+     */
+    void clear();
+
+    size_t sample_size() const { return sample; }
+    size_t aging_count() const { return agings; }
+    size_t memory_bytes() const { return table.size() * sizeof(uint64_t); }
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "AudioTrack.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Columnar (structure-of-arrays) copy of the library's track metadata
+ *
+ * One row per library track, in library order, so row = 1-based track index
+ * - 1. Each field lives in its own contiguous column; library-wide scans,
+ * filters and totals read only the columns they need instead of chasing
+ * PlaylistNode and AudioTrack pointers.
+ *
+ * The scan kernels walk fixed 8-row blocks with one accumulator per lane:
+ * GCC vectorises that shape at -O2, where a plain loop needing a scalar
+ * epilogue is left scalar.
+ */
+class TrackMetadataTable {
+private:
+    std::vector<int32_t> durations;    // Seconds
+    std::vector<int32_t> bpms;
+    std::vector<TrackFormat> formats;
+    std::vector<int32_t> rates;        // MP3 bitrate (kbps) or WAV sample rate (Hz)
+    std::vector<int32_t> bit_depths;   // WAV bit depth; 0 for MP3
+
+public:
+    TrackMetadataTable() : durations(), bpms(), formats(), rates(), bit_depths() {}
+
+    size_t size() const { return durations.size(); }
+    void reserve(size_t rows);
+    void clear();
+
+    /**
+     * @brief Append one track's metadata
+     * @return The new row
+     */
+    size_t append(TrackFormat format, int duration_seconds, int bpm, int rate, int bit_depth);
+
+    /**
+     * @brief Parse a config track type ("MP3"/"WAV")
+     * @return false for any other type
+     */
+    static bool parse_format(const std::string& type, TrackFormat& format);
+
+    // ========== COLUMNS ==========
+    const int32_t* duration_column() const { return durations.data(); }
+    const int32_t* bpm_column() const { return bpms.data(); }
+    const TrackFormat* format_column() const { return formats.data(); }
+    const int32_t* rate_column() const { return rates.data(); }
+    const int32_t* bit_depth_column() const { return bit_depths.data(); }
+
+    // ========== SCANS ==========
+
+    /**
+     * @brief Sum of every row's duration, in seconds
+     */
+    int64_t total_duration() const;
+
+    /**
+     * @brief Sum of the durations of the given rows (e.g. a playlist's tracks)
+     */
+    int64_t total_duration(const std::vector<uint32_t>& rows) const;
+
+    /**
+     * @brief Sum of durations of rows in one format
+     */
+    int64_t total_duration(TrackFormat format) const;
+
+    /**
+     * @brief Rows with low <= BPM <= high
+     */
+    size_t count_bpm_range(int low, int high) const;
+
+    /**
+     * @brief The rows with low <= BPM <= high, ascending
+     */
+    std::vector<uint32_t> select_bpm_range(int low, int high) const;
+
+    /**
+     * @brief Mean BPM over all rows (0 for an empty table)
+     */
+    double mean_bpm() const;
+};
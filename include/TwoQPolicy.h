@@ -0,0 +1,38 @@
+#pragma once
+
+#include "EvictionPolicy.h"
+#include <string>
+
+/**
+ * @brief 2Q eviction (Johnson & Shasha, full version)
+ *
+ * New tracks enter the A1in FIFO. Tracks evicted from A1in leave a ghost in
+ * A1out; a miss that finds its key there is promoted straight into the Am
+ * LRU list. One-off tracks therefore never displace the Am working set.
+ * Sizing follows the paper: Kin = 25% and Kout = 50% of capacity.
+ */
+class TwoQPolicy : public EvictionPolicy {
+private:
+    enum Queue { NONE = 0, A1IN = 1, AM = 2 };
+
+    SlotList a1in;
+    SlotList am;
+    GhostList a1out;
+    size_t kin;
+    size_t kout;
+    Queue pending_queue;    // Where the next insert goes (decided in onMiss)
+
+public:
+    TwoQPolicy() : a1in(), am(), a1out(), kin(1), kout(1), pending_queue(A1IN) {}
+
+    const char* name() const override { return "2q"; }
+    void attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) override;
+    void onCapacityChange(size_t cache_capacity) override;
+    void onMiss(const std::string& key) override;
+    void onInsert(size_t idx) override;
+    void onHit(size_t idx) override;
+    void onRemove(size_t idx) override;
+    void onMove(size_t from, size_t to) override;
+    size_t selectVictim() override;
+    void onEvict(size_t idx) override;
+};
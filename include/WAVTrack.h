@@ -27,32 +27,37 @@ public:
     WAVTrack(const std::string& title, const std::vector<std::string>& artists, 
              int duration, int bpm, int sample_rate, int bit_depth);
 
-    // ========== TODO: IMPLEMENT VIRTUAL FUNCTIONS ==========
+    // ========== VIRTUAL FUNCTION IMPLEMENTATIONS ==========
 
     /**
-     * TODO: Implement load function for WAV files
-     * HINT: WAV files are uncompressed, so loading might be faster
+     * Simulate loading: format and estimated stereo PCM file size
      */
     void load() override;
 
     /**
-     * TODO: Implement beat grid analysis for WAV
-     * HINT: Uncompressed audio allows more precise beat detection
+     * Report the estimated beats; precision factor 1.0 (uncompressed)
      */
     void analyze_beatgrid() override;
 
     /**
-     * TODO: Implement quality score calculation
-     * HINT: Use sample rate and bit depth for quality (both higher = better)
+     * Quality 70-100: base 70, plus up to 15 for sample rate and up to 15 for bit depth
      */
     double get_quality_score() const override;
 
+    TrackFormat get_format() const override { return TrackFormat::WAV; }
+
     /**
-     * TODO: Implement clone function
-     * HINT: Return a unique_ptr to a new WAVTrack with same properties
+     * Polymorphic copy (shares waveform and analysis with this track)
      */
     PointerWrapper<AudioTrack> clone() const override;
 
+    /**
+     * Stereo PCM: duration x sample rate x bytes per sample x 2 (the size load() reports)
+     */
+    size_t audio_bytes() const override;
+
+    size_t memory_footprint() const override { return sizeof(WAVTrack) + audio_bytes() + heap_footprint(); }
+
     // Getters
     int get_sample_rate() const { return sample_rate; }
     int get_bit_depth() const { return bit_depth; }
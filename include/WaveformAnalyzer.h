@@ -0,0 +1,71 @@
+#pragma once
+
+#include "WaveformBuffer.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Level and texture measurements of one waveform
+ */
+struct WaveformStats {
+    size_t samples = 0;
+    double rms = 0.0;                          // Root mean square level
+    double peak = 0.0;                         // Largest absolute sample
+    double crest_factor = 0.0;                 // peak / rms (0 for silence)
+    double zero_crossing_rate = 0.0;           // Sign changes per adjacent sample pair
+    size_t window = 0;                         // Samples per envelope window
+    std::vector<double> energy_envelope = {};  // RMS of each window (last one may be shorter)
+};
+
+/**
+ * @brief Vectorised waveform analysis kernels (Helper)
+ *
+ * One pass over the samples yields every WaveformStats field. The inner
+ * kernel exists in three variants, picked once at startup from what the CPU
+ * supports: AVX2 (4 doubles per step), SSE2 (2 per step) and a portable
+ * scalar loop. Float64 buffers are analysed in place; compact formats are
+ * decoded one window at a time into a small scratch buffer.
+ *
+ * Vector variants sum in a different order than the scalar one, so rms and
+ * envelope values can differ from it in the last few bits.
+ */
+class WaveformAnalyzer {
+public:
+    enum class Isa { Scalar, SSE2, AVX2 };
+
+    static const size_t DEFAULT_WINDOW = 1024;
+
+    /**
+     * @brief Analyse a waveform buffer in any SampleFormat
+     * @param window Samples per energy envelope window (0 is treated as 1)
+     */
+    static WaveformStats analyze(const WaveformBuffer& waveform, size_t window = DEFAULT_WINDOW);
+
+    /**
+     * @brief Analyse count float64 samples
+     */
+    static WaveformStats analyze(const double* samples, size_t count, size_t window = DEFAULT_WINDOW);
+
+    /**
+     * @brief Straightforward one-sample-at-a-time reference (for tests and benchmarks)
+     */
+    static WaveformStats analyze_reference(const double* samples, size_t count,
+                                           size_t window = DEFAULT_WINDOW);
+
+    /**
+     * @brief Kernel variant in use
+     */
+    static Isa active_isa();
+
+    /**
+     * @brief Best variant this CPU supports
+     */
+    static Isa best_isa();
+
+    /**
+     * @brief Use a specific variant (clamped to best_isa()); for benchmarks
+     */
+    static void set_isa(Isa isa);
+
+    static const char* isa_name(Isa isa);
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief How waveform samples are stored in memory
+ *
+ * Samples are always exchanged as doubles in [-1, 1]; the format only decides
+ * storage precision and size.
+ * - Float64: 8 bytes, exact
+ * - Float32: 4 bytes, ~7 significant digits
+ * - Int16:   2 bytes, 16-bit PCM
+ * - MuLaw8:  1 byte, 8-bit mu-law (G.711 curve), finer near silence
+ */
+enum class SampleFormat : uint8_t { Float64, Float32, Int16, MuLaw8 };
+
+/**
+ * @brief Reference-counted, copy-on-write waveform samples
+ *
+ * Copying a WaveformBuffer shares the samples instead of duplicating them, so
+ * the library, cache and deck copies of a track all read the same block.
+ * Samples are only duplicated when a holder writes (write(), edit_raw()) while
+ * another holder still references them. The reference count is atomic, so
+ * handles to the same block may be copied and dropped from different threads;
+ * writing still requires exclusive access to the handle.
+ *
+ * Storage uses a SampleFormat. New buffers use default_format(): Float64
+ * unless the build defines WAVEFORM_SAMPLE_FORMAT (e.g. -DWAVEFORM_SAMPLE_FORMAT=Int16)
+ * or set_default_format() is called (waveform_format= in dj_config.txt).
+ */
+class WaveformBuffer {
+public:
+    /**
+     * @brief Process-wide allocation counters (for benchmarks and diagnostics)
+     */
+    struct Stats {
+        size_t allocations;      // Sample blocks allocated (fresh or copy-on-write)
+        size_t bytes_allocated;  // Sample bytes in those blocks
+        size_t shares;           // Copies that shared an existing block instead
+    };
+
+    /**
+     * @brief Construct an empty buffer (no samples, no allocation)
+     */
+    WaveformBuffer();
+
+    /**
+     * @brief Allocate an unshared block of silent (zero) samples
+     * @param samples Number of samples
+     * @param format Storage format
+     */
+    explicit WaveformBuffer(size_t samples, SampleFormat format = default_format());
+
+    ~WaveformBuffer();
+
+    WaveformBuffer(const WaveformBuffer& other);
+    WaveformBuffer& operator=(const WaveformBuffer& other);
+    WaveformBuffer(WaveformBuffer&& other) noexcept;
+    WaveformBuffer& operator=(WaveformBuffer&& other) noexcept;
+
+    size_t size() const { return block ? block->size : 0; }
+    bool empty() const { return block == nullptr; }
+    SampleFormat format() const { return block ? block->format : SampleFormat::Float64; }
+
+    /**
+     * @brief Bytes of sample storage (size() * sample_bytes(format()))
+     */
+    size_t bytes() const { return block ? block->size * sample_bytes(block->format) : 0; }
+
+    /**
+     * @brief Sample i converted to double (i must be < size())
+     */
+    double at(size_t i) const;
+
+    /**
+     * @brief Convert count samples starting at offset into out
+     * @return Number of samples copied (clamped to the end of the buffer)
+     */
+    size_t read(size_t offset, double* out, size_t count) const;
+
+    /**
+     * @brief Quantise count samples from in into the buffer starting at offset
+     * First makes a private copy if the block is shared. Values are clamped to [-1, 1].
+     * @return Number of samples written (clamped to the end of the buffer)
+     */
+    size_t write(size_t offset, const double* in, size_t count);
+
+    /**
+     * @brief Samples in their stored format (for format-aware kernels), or nullptr when empty
+     */
+    const void* raw() const;
+
+    /**
+     * @brief Writable samples in their stored format; first makes a private copy if shared
+     * @return Pointer valid until this handle is copied from, assigned or destroyed
+     */
+    void* edit_raw();
+
+    /**
+     * @brief True if no other handle references these samples
+     */
+    bool unique() const;
+
+    /**
+     * @brief Drop this handle's reference and become empty
+     */
+    void reset();
+
+    static Stats stats();
+
+    /**
+     * @brief Format used by buffers constructed without an explicit one
+     */
+    static SampleFormat default_format();
+    static void set_default_format(SampleFormat format);
+
+    static size_t sample_bytes(SampleFormat format);
+    static const char* format_name(SampleFormat format);
+
+    /**
+     * @brief Parse "float64", "float32", "int16" or "mulaw8" (case-insensitive)
+     * @return true if the name is known
+     */
+    static bool parse_format(const std::string& name, SampleFormat& format);
+
+private:
+    // Header of a single allocation holding the count followed by the samples
+    struct Block {
+        std::atomic<size_t> refs;
+        size_t size;
+        SampleFormat format;
+    };
+
+    Block* block;
+
+    static Block* allocate(size_t samples, SampleFormat format);
+    static unsigned char* samples_of(Block* b);
+    static void release(Block* b);
+};
@@ -0,0 +1,113 @@
+#include "ARCPolicy.h"
+#include <algorithm>
+
+void ARCPolicy::attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) {
+    EvictionPolicy::attach(slot_storage, cache_capacity);
+    t1.clear();
+    t2.clear();
+    b1.clear();
+    b2.clear();
+    target_t1 = 0;
+    pending_queue = T1;
+    pending_from_b2 = false;
+}
+
+void ARCPolicy::onCapacityChange(size_t cache_capacity) {
+    EvictionPolicy::onCapacityChange(cache_capacity);
+    // A shrink must not leave p above c, or ghosts beyond the smaller directory
+    target_t1 = std::min(target_t1, capacity);
+    trimGhosts();
+}
+
+void ARCPolicy::onMiss(const std::string& key) {
+    pending_from_b2 = false;
+    if (b1.contains(key)) {
+        // Recency side was too small: grow T1's target
+        size_t delta = std::max<size_t>(1, b2.size() / b1.size());
+        target_t1 = std::min(capacity, target_t1 + delta);
+        b1.erase(key);
+        pending_queue = T2;
+    } else if (b2.contains(key)) {
+        // Frequency side was too small: shrink T1's target
+        size_t delta = std::max<size_t>(1, b1.size() / b2.size());
+        target_t1 = target_t1 > delta ? target_t1 - delta : 0;
+        b2.erase(key);
+        pending_queue = T2;
+        pending_from_b2 = true;
+    } else {
+        pending_queue = T1;
+    }
+}
+
+void ARCPolicy::onInsert(size_t idx) {
+    if (pending_queue == T2) {
+        (*slots)[idx].tag = T2;
+        t2.pushFront(*slots, idx);
+    } else {
+        (*slots)[idx].tag = T1;
+        t1.pushFront(*slots, idx);
+    }
+    pending_queue = T1;
+    pending_from_b2 = false;
+    trimGhosts();
+}
+
+void ARCPolicy::onHit(size_t idx) {
+    CacheSlot& slot = (*slots)[idx];
+    if (slot.tag == T1) {
+        t1.remove(*slots, idx);
+    } else {
+        t2.remove(*slots, idx);
+    }
+    slot.tag = T2;
+    t2.pushFront(*slots, idx);
+}
+
+void ARCPolicy::onRemove(size_t idx) {
+    CacheSlot& slot = (*slots)[idx];
+    if (slot.tag == T1) {
+        t1.remove(*slots, idx);
+    } else if (slot.tag == T2) {
+        t2.remove(*slots, idx);
+    }
+    slot.tag = NONE;
+}
+
+void ARCPolicy::onMove(size_t from, size_t to) {
+    if ((*slots)[to].tag == T1) {
+        t1.relink(*slots, from, to);
+    } else if ((*slots)[to].tag == T2) {
+        t2.relink(*slots, from, to);
+    }
+}
+
+size_t ARCPolicy::selectVictim() {
+    // REPLACE(p): take from T1 when it is over target (or at target on a B2 ghost hit)
+    bool from_t1 = !t1.empty() &&
+                   (t1.size() > target_t1 || (pending_from_b2 && t1.size() == target_t1) || t2.empty());
+    return from_t1 ? t1.tail() : t2.tail();
+}
+
+void ARCPolicy::onEvict(size_t idx) {
+    const std::string& key = (*slots)[idx].getKey();
+    if ((*slots)[idx].tag == T1) {
+        b1.pushFront(key);
+    } else {
+        b2.pushFront(key);
+    }
+    onRemove(idx);
+}
+
+void ARCPolicy::trimGhosts() {
+    // Directory bounds: |T1| + |B1| <= c and |T1| + |T2| + |B1| + |B2| <= 2c
+    while (!b1.empty() && t1.size() + b1.size() > capacity) {
+        b1.popBack();
+    }
+    while ((!b1.empty() || !b2.empty()) && t1.size() + t2.size() + b1.size() + b2.size() > 2 * capacity) {
+        if (b2.size() > 0) {
+            b2.popBack();
+        } else {
+            b1.popBack();
+        }
+    }
+}
@@ -1,24 +1,40 @@
 #include "AudioTrack.h"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
-#include <random>
+#include <cstdint>
 
-AudioTrack::AudioTrack(const std::string& title, const std::vector<std::string>& artists, 
-                      int duration, int bpm, size_t waveform_samples)
-    : title(title), artists(artists), duration_seconds(duration), bpm(bpm), 
-      waveform_size(waveform_samples) {
-
-    // Allocate memory for waveform analysis
-    waveform_data = new double[waveform_size];
+namespace {
 
-    // Generate some dummy waveform data for testing
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+InternedString join_artists(const std::vector<std::string>& artists) {
+    std::string line;
+    for (const std::string& artist : artists) {
+        if (!line.empty()) {
+            line += ", ";
+        }
+        line += artist;
+    }
+    return InternedString(line);
+}
 
-    for (size_t i = 0; i < waveform_size; ++i) {
-        waveform_data[i] = dis(gen);
+std::shared_ptr<const std::vector<InternedString> > intern_all(const std::vector<std::string>& values) {
+    std::shared_ptr<std::vector<InternedString> > interned = std::make_shared<std::vector<InternedString> >();
+    interned->reserve(values.size());
+    for (const std::string& value : values) {
+        interned->push_back(InternedString(value));
     }
+    return interned;
+}
+
+} // namespace
+
+AudioTrack::AudioTrack(const std::string& title, const std::vector<std::string>& artists, 
+                      int duration, int bpm, size_t waveform_samples)
+    : title(title), id(0), artists(intern_all(artists)),
+      artist_line(join_artists(artists)), duration_seconds(duration), bpm(bpm), 
+      waveform_size(waveform_samples), waveform(), waveform_stats(), beat_grid() {
+    // Samples are generated by waveform_buffer() on first access
     #ifdef DEBUG
     std::cout << "AudioTrack created: " << title << " by " << std::endl;
     for (const auto& artist : artists) {
@@ -28,54 +44,204 @@ AudioTrack::AudioTrack(const std::string& title, const std::vector<std::string>&
     #endif
 }
 
-// ========== TODO: STUDENTS IMPLEMENT RULE OF 5 ==========
+// ========== RULE OF 5 ==========
 
 AudioTrack::~AudioTrack() {
-    // TODO: Implement the destructor
     #ifdef DEBUG
     std::cout << "AudioTrack destructor called for: " << title << std::endl;
     #endif
-    // Your code here...
 }
 
 AudioTrack::AudioTrack(const AudioTrack& other)
-{
-    // TODO: Implement the copy constructor
+    : title(other.title), id(other.id), artists(other.artists),
+      artist_line(other.artist_line), duration_seconds(other.duration_seconds),
+      bpm(other.bpm), waveform_size(other.waveform_size), waveform(other.waveform),
+      waveform_stats(other.waveform_stats), beat_grid(other.beat_grid) {
     #ifdef DEBUG
     std::cout << "AudioTrack copy constructor called for: " << other.title << std::endl;
     #endif
-    // Your code here...
 }
 
 AudioTrack& AudioTrack::operator=(const AudioTrack& other) {
-    // TODO: Implement the copy assignment operator
     #ifdef DEBUG
     std::cout << "AudioTrack copy assignment called for: " << other.title << std::endl;
     #endif
-    // Your code here...
+    if (this == &other) {
+        return *this;
+    }
+    waveform_size = other.waveform_size;
+    waveform = other.waveform;
+    waveform_stats = other.waveform_stats;
+    beat_grid = other.beat_grid;
+    title = other.title;
+    artists = other.artists;
+    artist_line = other.artist_line;
+    id = other.id;
+    duration_seconds = other.duration_seconds;
+    bpm = other.bpm;
     return *this;
 }
 
-AudioTrack::AudioTrack(AudioTrack&& other) noexcept {
-    // TODO: Implement the move constructor
+AudioTrack::AudioTrack(AudioTrack&& other) noexcept
+    : title(std::move(other.title)), id(other.id), artists(other.artists),
+      artist_line(other.artist_line), duration_seconds(other.duration_seconds), bpm(other.bpm),
+      waveform_size(other.waveform_size), waveform(std::move(other.waveform)),
+      waveform_stats(std::move(other.waveform_stats)), beat_grid(std::move(other.beat_grid)) {
     #ifdef DEBUG
-    std::cout << "AudioTrack move constructor called for: " << other.title << std::endl;
+    std::cout << "AudioTrack move constructor called for: " << title << std::endl;
     #endif
-    // Your code here...
 }
 
 AudioTrack& AudioTrack::operator=(AudioTrack&& other) noexcept {
-    // TODO: Implement the move assignment operator
-
     #ifdef DEBUG
     std::cout << "AudioTrack move assignment called for: " << other.title << std::endl;
     #endif
-    // Your code here...
+    if (this == &other) {
+        return *this;
+    }
+    title = std::move(other.title);
+    artists = other.artists;  // Shared and immutable: the moved-from track keeps a valid list
+    artist_line = other.artist_line;
+    id = other.id;
+    duration_seconds = other.duration_seconds;
+    bpm = other.bpm;
+    waveform_size = other.waveform_size;
+    waveform = std::move(other.waveform);
+    waveform_stats = std::move(other.waveform_stats);
+    beat_grid = std::move(other.beat_grid);
     return *this;
 }
 
+namespace {
+
+// FNV-1a over the bytes of str, continuing from hash
+uint64_t fnv1a(uint64_t hash, const std::string& str) {
+    for (unsigned char c : str) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    // Separator so ("ab", "c") and ("a", "bc") hash differently
+    hash ^= 0xff;
+    hash *= 1099511628211ULL;
+    return hash;
+}
+
+// SplitMix64: small, fast and fully specified, so samples match on every platform
+uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+namespace {
+thread_local std::ostream* construction_stream = nullptr;
+}
+
+std::ostream& AudioTrack::construction_log() {
+    return construction_stream ? *construction_stream : std::cout;
+}
+
+void AudioTrack::set_construction_log(std::ostream* stream) {
+    construction_stream = stream;
+}
+
+QualityTier AudioTrack::get_quality_tier() const {
+    const double score = get_quality_score();
+    if (score < 50.0) {
+        return QualityTier::Low;
+    }
+    if (score < 75.0) {
+        return QualityTier::Standard;
+    }
+    return score < 90.0 ? QualityTier::High : QualityTier::Studio;
+}
+
+size_t AudioTrack::heap_footprint() const {
+    // Not built yet: charge what waveform_buffer() will allocate
+    size_t bytes = waveform.empty()
+        ? waveform_size * WaveformBuffer::sample_bytes(WaveformBuffer::default_format())
+        : waveform.bytes();
+    if (waveform_stats) {
+        bytes += sizeof(WaveformStats) + waveform_stats->energy_envelope.capacity() * sizeof(double);
+    }
+    if (beat_grid && beat_grid->detected) {
+        bytes += sizeof(BeatGrid) + beat_grid->beat_times.capacity() * sizeof(double);
+    }
+    // Title and artist text lives once in the intern pool, not per track
+    bytes += artists->capacity() * sizeof(InternedString);
+    return bytes;
+}
+
+WaveformBuffer& AudioTrack::waveform_buffer() const {
+    if (waveform.empty() && waveform_size > 0) {
+        // Dummy waveform data for testing, seeded by track identity
+        uint64_t state = 14695981039346656037ULL;
+        state = fnv1a(state, title);
+        for (const auto& artist : *artists) {
+            state = fnv1a(state, artist);
+        }
+        // Generated in chunks and quantised into the buffer's storage format
+        WaveformBuffer generated(waveform_size);
+        double chunk[256];
+        for (size_t offset = 0; offset < waveform_size; offset += 256) {
+            size_t count = std::min<size_t>(256, waveform_size - offset);
+            for (size_t i = 0; i < count; ++i) {
+                // Top 53 bits -> [0, 1) -> [-1, 1)
+                chunk[i] = static_cast<double>(splitmix64(state) >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+            }
+            generated.write(offset, chunk, count);
+        }
+        waveform = std::move(generated);
+    }
+    return waveform;
+}
+
 void AudioTrack::get_waveform_copy(double* buffer, size_t buffer_size) const {
-    if (buffer && waveform_data && buffer_size <= waveform_size) {
-        std::memcpy(buffer, waveform_data, buffer_size * sizeof(double));
+    const WaveformBuffer& samples = waveform_buffer();
+    if (buffer && !samples.empty() && buffer_size <= samples.size()) {
+        samples.read(0, buffer, buffer_size);
+    }
+}
+
+const WaveformStats& AudioTrack::get_waveform_stats() const {
+    if (!waveform_stats) {
+        waveform_stats = std::make_shared<const WaveformStats>(WaveformAnalyzer::analyze(waveform_buffer()));
+    }
+    return *waveform_stats;
+}
+
+const BeatGrid& AudioTrack::get_beat_grid() const {
+    if (!beat_grid) {
+        // One shared "nothing found" result for every track that cannot be analysed
+        static const std::shared_ptr<const BeatGrid> undetected = std::make_shared<const BeatGrid>();
+        const double sample_rate = duration_seconds > 0
+            ? static_cast<double>(waveform_size) / duration_seconds : 0.0;
+        // Checked first so coarse waveforms are never generated just to be rejected
+        if (BeatDetector::can_resolve(waveform_size, sample_rate)) {
+            BeatGrid grid = BeatDetector::detect(waveform_buffer(), sample_rate);
+            beat_grid = grid.detected ? std::make_shared<const BeatGrid>(std::move(grid)) : undetected;
+        } else {
+            beat_grid = undetected;
+        }
+    }
+    return *beat_grid;
+}
+
+int AudioTrack::estimate_beats() const {
+    const BeatGrid& grid = get_beat_grid();
+    if (!grid.detected) {
+        return static_cast<int>((duration_seconds / 60.0) * bpm);
     }
+    std::cout << "  → Onset detection: " << grid.bpm << " BPM (confidence "
+              << grid.confidence << ", " << grid.beat_times.size() << " beats)\n";
+    return static_cast<int>(grid.beat_times.size());
+}
+
+size_t AudioTrack::write_waveform(size_t offset, const double* samples, size_t count) {
+    waveform_stats.reset();
+    beat_grid.reset();
+    return waveform_buffer().write(offset, samples, count);
 }
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "BeatDetector.h"
+#include "FFT.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+constexpr double BeatDetector::MIN_BPM;
+constexpr double BeatDetector::MAX_BPM;
+constexpr double BeatDetector::MIN_CONFIDENCE;
+
+namespace {
+
+const size_t MIN_FRAME = 16;
+const size_t MAX_FRAME = 4096;
+const int COMB_HARMONICS = 4;
+const double BPM_STEP = 0.5;
+
+// ~46 ms analysis frames (2048 samples at 44.1 kHz), 75% overlap
+size_t frame_size_for(double sample_rate) {
+    size_t frame = FFT::next_power_of_two(static_cast<size_t>(sample_rate * 0.046));
+    return std::min(MAX_FRAME, std::max(MIN_FRAME, frame));
+}
+
+size_t hop_for(size_t frame) {
+    return frame / 4;
+}
+
+// Linear interpolation of r at a fractional lag (0 past the end)
+double sample_at(const std::vector<double>& r, double lag) {
+    const size_t i = static_cast<size_t>(lag);
+    if (i + 1 >= r.size()) return 0.0;
+    const double frac = lag - static_cast<double>(i);
+    return r[i] * (1.0 - frac) + r[i + 1] * frac;
+}
+
+} // namespace
+
+bool BeatDetector::can_resolve(size_t count, double sample_rate) {
+    if (!(sample_rate > 0.0)) return false;
+    const size_t frame = frame_size_for(sample_rate);
+    const double envelope_rate = sample_rate / static_cast<double>(hop_for(frame));
+    // Four envelope frames per beat at MAX_BPM, and four beats at MIN_BPM
+    const bool fast_enough = envelope_rate >= 4.0 * MAX_BPM / 60.0;
+    const bool long_enough = static_cast<double>(count) >= sample_rate * 4.0 * 60.0 / MIN_BPM;
+    return fast_enough && long_enough && count >= frame;
+}
+
+BeatGrid BeatDetector::detect(const WaveformBuffer& waveform, double sample_rate) {
+    if (!can_resolve(waveform.size(), sample_rate)) {
+        return BeatGrid();
+    }
+    if (waveform.format() == SampleFormat::Float64) {
+        return detect(static_cast<const double*>(waveform.raw()), waveform.size(), sample_rate);
+    }
+    std::vector<double> samples(waveform.size());
+    waveform.read(0, samples.data(), samples.size());
+    return detect(samples.data(), samples.size(), sample_rate);
+}
+
+BeatGrid BeatDetector::detect(const double* samples, size_t count, double sample_rate) {
+    BeatGrid grid;
+    if (!samples || !can_resolve(count, sample_rate)) {
+        return grid;
+    }
+
+    double envelope_rate = 0.0;
+    std::vector<double> envelope = onset_envelope(samples, count, sample_rate, envelope_rate);
+
+    // Lag range for 60-200 BPM, plus room for the comb's higher harmonics
+    const double min_lag = 60.0 * envelope_rate / MAX_BPM;
+    const double max_lag = 60.0 * envelope_rate / MIN_BPM;
+    const size_t comb_reach = static_cast<size_t>(std::ceil(max_lag * COMB_HARMONICS)) + 2;
+    std::vector<double> r = autocorrelation(envelope, std::min(comb_reach, envelope.size() - 1));
+    if (r.empty() || r[0] <= 0.0) {
+        return grid;
+    }
+
+    double best_score = -1.0;
+    double best_bpm = 0.0;
+    for (double bpm = MIN_BPM; bpm <= MAX_BPM; bpm += BPM_STEP) {
+        const double lag = 60.0 * envelope_rate / bpm;
+        double comb = 0.0;
+        for (int k = 1; k <= COMB_HARMONICS; ++k) {
+            comb += sample_at(r, lag * k);
+        }
+        const double octaves = std::log2(bpm / 120.0);
+        const double score = comb * std::exp(-0.5 * octaves * octaves);
+        if (score > best_score) {
+            best_score = score;
+            best_bpm = bpm;
+        }
+    }
+    const double period = 60.0 * envelope_rate / best_bpm;
+    if (period < min_lag - 1.0 || period > max_lag + 1.0) {
+        return grid;
+    }
+    grid.confidence = std::max(0.0, sample_at(r, period) / r[0]);
+    if (grid.confidence < MIN_CONFIDENCE) {
+        return grid;
+    }
+
+    // Phase: the offset whose comb of beats lands on the most onset energy
+    const size_t phases = static_cast<size_t>(std::ceil(period));
+    double best_phase_energy = -1.0;
+    double best_phase = 0.0;
+    for (size_t phase = 0; phase < phases; ++phase) {
+        double energy = 0.0;
+        for (double t = static_cast<double>(phase); t < envelope.size(); t += period) {
+            energy += envelope[static_cast<size_t>(t)];
+        }
+        if (energy > best_phase_energy) {
+            best_phase_energy = energy;
+            best_phase = static_cast<double>(phase);
+        }
+    }
+
+    grid.detected = true;
+    grid.bpm = best_bpm;
+    const double hop_seconds = 1.0 / envelope_rate;
+    for (double t = best_phase; t < envelope.size(); t += period) {
+        grid.beat_times.push_back(t * hop_seconds);
+    }
+    return grid;
+}
+
+std::vector<double> BeatDetector::onset_envelope(const double* samples, size_t count, double sample_rate,
+                                                 double& envelope_rate) {
+    const size_t frame = frame_size_for(sample_rate);
+    const size_t hop = hop_for(frame);
+    envelope_rate = sample_rate / static_cast<double>(hop);
+    std::vector<double> flux;
+    if (!samples || count < frame) {
+        return flux;
+    }
+
+    const double pi = std::acos(-1.0);
+    std::vector<double> window(frame);
+    for (size_t i = 0; i < frame; ++i) {
+        window[i] = 0.5 - 0.5 * std::cos(2.0 * pi * static_cast<double>(i) / static_cast<double>(frame));
+    }
+
+    const FFT fft(frame);
+    const size_t bins = frame / 2 + 1;
+    std::vector<std::complex<double> > spectrum(frame);
+    std::vector<double> magnitude(bins, 0.0);
+    std::vector<double> previous(bins, 0.0);
+    flux.reserve((count - frame) / hop + 1);
+
+    for (size_t start = 0; start + frame <= count; start += hop) {
+        for (size_t i = 0; i < frame; ++i) {
+            spectrum[i] = std::complex<double>(samples[start + i] * window[i], 0.0);
+        }
+        fft.forward(spectrum.data());
+        double positive_change = 0.0;
+        for (size_t k = 0; k < bins; ++k) {
+            // Log compression keeps loud bins from drowning out onsets elsewhere
+            magnitude[k] = std::log1p(100.0 * std::sqrt(std::norm(spectrum[k])));
+            positive_change += std::max(0.0, magnitude[k] - previous[k]);
+        }
+        // The first frame has nothing to rise from
+        flux.push_back(start == 0 ? 0.0 : positive_change);
+        previous.swap(magnitude);
+    }
+    return flux;
+}
+
+std::vector<double> BeatDetector::autocorrelation(const std::vector<double>& x, size_t max_lag) {
+    std::vector<double> r;
+    if (x.empty()) {
+        return r;
+    }
+    double mean = 0.0;
+    for (double v : x) mean += v;
+    mean /= static_cast<double>(x.size());
+
+    // Zero-pad to >= 2n so the circular correlation equals the linear one
+    const FFT fft(FFT::next_power_of_two(2 * x.size()));
+    std::vector<std::complex<double> > spectrum(fft.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        spectrum[i] = std::complex<double>(x[i] - mean, 0.0);
+    }
+    fft.forward(spectrum.data());
+    for (auto& bin : spectrum) {
+        bin = std::complex<double>(std::norm(bin), 0.0);
+    }
+    fft.inverse(spectrum.data());
+
+    max_lag = std::min(max_lag, x.size() - 1);
+    r.resize(max_lag + 1);
+    for (size_t lag = 0; lag <= max_lag; ++lag) {
+        r[lag] = spectrum[lag].real();
+    }
+    return r;
+}
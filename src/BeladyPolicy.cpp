@@ -0,0 +1,78 @@
+#include "BeladyPolicy.h"
+#include <algorithm>
+
+const uint64_t BeladyPolicy::NEVER;
+
+void BeladyPolicy::attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) {
+    EvictionPolicy::attach(slot_storage, cache_capacity);
+    // The plan outlives storage rebuilds; only per-slot state is dropped
+    by_next_use.clear();
+}
+
+uint64_t BeladyPolicy::nextUse(const std::string& key) const {
+    auto it = occurrences.find(key);
+    if (it == occurrences.end()) return NEVER;
+    auto next = std::lower_bound(it->second.begin(), it->second.end(), next_position);
+    return next == it->second.end() ? NEVER : static_cast<uint64_t>(*next);
+}
+
+void BeladyPolicy::track(size_t idx) {
+    CacheSlot& slot = (*slots)[idx];
+    slot.frequency = nextUse(slot.getKey());
+    by_next_use.insert(std::make_pair(slot.frequency, idx));
+}
+
+void BeladyPolicy::untrack(size_t idx) {
+    by_next_use.erase(std::make_pair((*slots)[idx].frequency, idx));
+}
+
+void BeladyPolicy::onInsert(size_t idx) {
+    track(idx);
+}
+
+void BeladyPolicy::onHit(size_t idx) {
+    untrack(idx);
+    track(idx);
+}
+
+void BeladyPolicy::onRemove(size_t idx) {
+    untrack(idx);
+}
+
+void BeladyPolicy::onMove(size_t from, size_t to) {
+    // frequency holds the next use the slot was filed under
+    const uint64_t next_use = (*slots)[to].frequency;
+    by_next_use.erase(std::make_pair(next_use, from));
+    by_next_use.insert(std::make_pair(next_use, to));
+}
+
+size_t BeladyPolicy::selectVictim() {
+    if (by_next_use.empty()) return CacheSlot::NIL;
+    return by_next_use.rbegin()->second;
+}
+
+void BeladyPolicy::onPlan(const std::vector<std::string>& sequence) {
+    occurrences.clear();
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        occurrences[sequence[i]].push_back(i);
+    }
+    next_position = 0;
+
+    // Residents from a previous plan get next uses in the new one
+    by_next_use.clear();
+    for (size_t idx = 0; idx < slots->size(); ++idx) {
+        if ((*slots)[idx].isOccupied()) {
+            track(idx);
+        }
+    }
+}
+
+void BeladyPolicy::onAdvance(size_t position) {
+    // The access at `position` is being served now; only later ones count as future
+    next_position = position + 1;
+}
+
+bool BeladyPolicy::admitPrefetch(const std::string& key) const {
+    if (by_next_use.empty()) return true;
+    return by_next_use.rbegin()->first > nextUse(key);
+}
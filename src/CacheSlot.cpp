@@ -1,13 +1,23 @@
 #include "CacheSlot.h"
 
+const size_t CacheSlot::NIL;
+
 CacheSlot::CacheSlot() : 
     track(nullptr), 
+    key(),
+    bytes(0),
     last_access_time(0), 
-    occupied(false){
+    occupied(false),
+    prev(NIL),
+    next(NIL),
+    frequency(0),
+    tag(0) {
 }
 
 void CacheSlot::store(PointerWrapper<AudioTrack> track_ptr, uint64_t access_time) {
     track = std::move(track_ptr);
+    key = track ? track->get_title_id() : InternedString();
+    bytes = track ? track->memory_footprint() : 0;
     last_access_time = access_time;
     occupied = true;
 }
@@ -23,6 +33,14 @@ AudioTrack* CacheSlot::access(uint64_t access_time) {
 
 void CacheSlot::clear() {
     track.reset(nullptr);
+    key = InternedString();
+    bytes = 0;
     occupied = false;
     last_access_time = 0;
-}
\ No newline at end of file
+}
+
+PointerWrapper<AudioTrack> CacheSlot::take() {
+    PointerWrapper<AudioTrack> taken(track.release());
+    clear();
+    return taken;
+}
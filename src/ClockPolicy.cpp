@@ -0,0 +1,45 @@
+#include "ClockPolicy.h"
+
+void ClockPolicy::attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) {
+    EvictionPolicy::attach(slot_storage, cache_capacity);
+    hand = 0;
+}
+
+void ClockPolicy::onInsert(size_t idx) {
+    (*slots)[idx].tag = 1;
+}
+
+void ClockPolicy::onHit(size_t idx) {
+    (*slots)[idx].tag = 1;
+}
+
+void ClockPolicy::onRemove(size_t idx) {
+    (*slots)[idx].tag = 0;
+    // The hand rests on a chosen victim until it is gone, so asking twice names the same slot
+    if (hand == idx) {
+        hand = (hand + 1) % slots->size();
+    }
+}
+
+void ClockPolicy::onCapacityChange(size_t cache_capacity) {
+    EvictionPolicy::onCapacityChange(cache_capacity);
+    // Storage may have shrunk below the hand; restart the sweep
+    if (hand >= cache_capacity) {
+        hand = 0;
+    }
+}
+
+size_t ClockPolicy::selectVictim() {
+    const size_t total = slots->size();
+    // Two sweeps suffice: the first clears every reference bit it passes
+    for (size_t step = 0; step < 2 * total; ++step) {
+        const size_t idx = hand;
+        CacheSlot& slot = (*slots)[idx];
+        if (slot.isOccupied() && !slot.tag) {
+            return idx;
+        }
+        slot.tag = 0;
+        hand = (hand + 1) % total;
+    }
+    return CacheSlot::NIL;
+}
@@ -0,0 +1,370 @@
+#include "ConfigSnapshot.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+const uint32_t ConfigSnapshot::VERSION;
+
+namespace {
+
+const char MAGIC[8] = {'D', 'J', 'S', 'N', 'A', 'P', '\0', '\0'};
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct StringRef {
+    uint32_t offset;  // Into the string pool (so the pool is limited to 4 GB)
+    uint32_t length;
+};
+
+struct Section {
+    uint64_t offset;  // From the start of the file
+    uint64_t count;   // Elements
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t file_size;
+    uint64_t source_size;
+    int64_t source_mtime_sec;
+    int64_t source_mtime_nsec;
+    Section tracks;
+    Section artists;
+    Section playlists;
+    Section indices;
+    Section strings;
+    // Scalar settings
+    StringRef app_name;
+    StringRef version_string;
+    StringRef cache_policy;
+    StringRef cache_admission;
+    StringRef waveform_format;
+    uint64_t controller_cache_bytes;
+    uint64_t controller_cache_ceiling;
+    int32_t controller_cache_size;
+    int32_t prefetch_lookahead;
+    int32_t library_build_threads;
+    int32_t default_crossfade_time;
+    int32_t bpm_tolerance;
+    uint8_t library_build_log;
+    uint8_t auto_sync;
+    uint8_t padding[2];
+};
+
+struct TrackRecord {
+    StringRef type;
+    StringRef title;
+    uint32_t first_artist;  // Into the artist refs
+    uint32_t artist_count;
+    int32_t duration_seconds;
+    int32_t bpm;
+    int32_t extra_param1;
+    int32_t extra_param2;
+};
+
+struct PlaylistRecord {
+    StringRef name;
+    uint32_t first_index;  // Into the playlist indices
+    uint32_t index_count;
+};
+
+static_assert(sizeof(Header) % 8 == 0, "snapshot header must keep sections aligned");
+static_assert(sizeof(TrackRecord) % 8 == 0, "snapshot track records must stay aligned");
+
+bool stat_source(const std::string& path, struct stat& info) {
+    return ::stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode);
+}
+
+size_t align8(size_t offset) {
+    return (offset + 7) & ~static_cast<size_t>(7);
+}
+
+const uint64_t MAX_POOL_BYTES = UINT32_MAX;
+
+// Accumulates the string pool while the snapshot is written
+class StringPool {
+private:
+    std::string bytes;
+    std::unordered_map<std::string, uint32_t> offsets;
+
+public:
+    StringPool() : bytes(), offsets() {}
+
+    // Repeated strings (types, artists, names) are stored once
+    StringRef add(const std::string& value) {
+        auto found = offsets.find(value);
+        if (found != offsets.end()) {
+            StringRef ref = {found->second, static_cast<uint32_t>(value.size())};
+            return ref;
+        }
+        StringRef ref = append(value);
+        offsets.emplace(value, ref.offset);
+        return ref;
+    }
+
+    // Strings that are (nearly) always unique, like titles, skip the dedupe table
+    StringRef append(const std::string& value) {
+        StringRef ref = {static_cast<uint32_t>(bytes.size()), static_cast<uint32_t>(value.size())};
+        bytes += value;
+        return ref;
+    }
+
+    bool overflowed() const { return bytes.size() > MAX_POOL_BYTES; }
+
+    const std::string& data() const { return bytes; }
+};
+
+// Bounds-checked view over a mapped snapshot
+class SnapshotView {
+private:
+    const char* base;
+    size_t size;
+    Header header;
+
+public:
+    SnapshotView(const char* data, size_t length) : base(data), size(length), header() {}
+
+    const Header& get_header() const { return header; }
+
+    bool validate(const struct stat& source) {
+        if (size < sizeof(Header)) return false;
+        std::memcpy(&header, base, sizeof(Header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) return false;
+        if (header.version != ConfigSnapshot::VERSION || header.byte_order != BYTE_ORDER_MARK) return false;
+        if (header.file_size != size) return false;
+        if (header.source_size != static_cast<uint64_t>(source.st_size) ||
+            header.source_mtime_sec != static_cast<int64_t>(source.st_mtim.tv_sec) ||
+            header.source_mtime_nsec != static_cast<int64_t>(source.st_mtim.tv_nsec)) {
+            return false;
+        }
+        return section_fits(header.tracks, sizeof(TrackRecord)) &&
+               section_fits(header.artists, sizeof(StringRef)) &&
+               section_fits(header.playlists, sizeof(PlaylistRecord)) &&
+               section_fits(header.indices, sizeof(int32_t)) &&
+               section_fits(header.strings, 1) &&
+               string_fits(header.app_name) && string_fits(header.version_string) &&
+               string_fits(header.cache_policy) && string_fits(header.cache_admission) &&
+               string_fits(header.waveform_format);
+    }
+
+    bool section_fits(const Section& section, size_t element) const {
+        return section.offset <= size && section.count <= (size - section.offset) / element;
+    }
+
+    bool string_fits(const StringRef& ref) const {
+        return ref.offset <= header.strings.count && ref.length <= header.strings.count - ref.offset;
+    }
+
+    template <typename Record>
+    Record record(const Section& section, uint64_t index) const {
+        Record value;
+        std::memcpy(&value, base + section.offset + index * sizeof(Record), sizeof(Record));
+        return value;
+    }
+
+    std::string string(const StringRef& ref) const {
+        return std::string(base + header.strings.offset + ref.offset, ref.length);
+    }
+};
+
+bool read_snapshot(const SnapshotView& view, SessionConfig& config) {
+    const Header& header = view.get_header();
+    SessionConfig loaded;
+    loaded.app_name = view.string(header.app_name);
+    loaded.version = view.string(header.version_string);
+    loaded.cache_policy = view.string(header.cache_policy);
+    loaded.cache_admission = view.string(header.cache_admission);
+    loaded.waveform_format = view.string(header.waveform_format);
+    loaded.controller_cache_bytes = static_cast<size_t>(header.controller_cache_bytes);
+    loaded.controller_cache_ceiling = static_cast<size_t>(header.controller_cache_ceiling);
+    loaded.controller_cache_size = header.controller_cache_size;
+    loaded.prefetch_lookahead = header.prefetch_lookahead;
+    loaded.library_build_threads = header.library_build_threads;
+    loaded.default_crossfade_time = header.default_crossfade_time;
+    loaded.bpm_tolerance = header.bpm_tolerance;
+    loaded.library_build_log = header.library_build_log != 0;
+    loaded.auto_sync = header.auto_sync != 0;
+
+    loaded.library_tracks.resize(header.tracks.count);
+    for (uint64_t i = 0; i < header.tracks.count; ++i) {
+        const TrackRecord record = view.record<TrackRecord>(header.tracks, i);
+        if (!view.string_fits(record.type) || !view.string_fits(record.title) ||
+            record.first_artist > header.artists.count ||
+            record.artist_count > header.artists.count - record.first_artist) {
+            return false;
+        }
+        SessionConfig::TrackInfo& info = loaded.library_tracks[i];
+        info.type = view.string(record.type);
+        info.title = view.string(record.title);
+        info.artists.reserve(record.artist_count);
+        for (uint64_t a = 0; a < record.artist_count; ++a) {
+            const StringRef artist = view.record<StringRef>(header.artists, record.first_artist + a);
+            if (!view.string_fits(artist)) return false;
+            info.artists.push_back(view.string(artist));
+        }
+        info.duration_seconds = record.duration_seconds;
+        info.bpm = record.bpm;
+        info.extra_param1 = record.extra_param1;
+        info.extra_param2 = record.extra_param2;
+    }
+
+    for (uint64_t p = 0; p < header.playlists.count; ++p) {
+        const PlaylistRecord record = view.record<PlaylistRecord>(header.playlists, p);
+        if (!view.string_fits(record.name) || record.first_index > header.indices.count ||
+            record.index_count > header.indices.count - record.first_index) {
+            return false;
+        }
+        std::vector<int>& indices = loaded.playlists[view.string(record.name)];
+        indices.reserve(record.index_count);
+        for (uint64_t i = 0; i < record.index_count; ++i) {
+            indices.push_back(view.record<int32_t>(header.indices, record.first_index + i));
+        }
+    }
+
+    config = std::move(loaded);
+    return true;
+}
+
+template <typename Record>
+void append_records(std::vector<char>& image, const std::vector<Record>& records) {
+    const char* bytes = reinterpret_cast<const char*>(records.data());
+    image.insert(image.end(), bytes, bytes + records.size() * sizeof(Record));
+    image.resize(align8(image.size()), '\0');
+}
+
+} // namespace
+
+std::string ConfigSnapshot::path_for(const std::string& config_path) {
+    return config_path + ".snap";
+}
+
+bool ConfigSnapshot::load(const std::string& snapshot_path, const std::string& config_path,
+                          SessionConfig& config) {
+    struct stat source;
+    if (!stat_source(config_path, source)) {
+        return false;
+    }
+    const int fd = ::open(snapshot_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat snapshot;
+    if (::fstat(fd, &snapshot) != 0 || snapshot.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    const size_t size = static_cast<size_t>(snapshot.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    SnapshotView view(static_cast<const char*>(mapped), size);
+    const bool loaded = view.validate(source) && read_snapshot(view, config);
+    ::munmap(mapped, size);
+    return loaded;
+}
+
+bool ConfigSnapshot::save(const std::string& snapshot_path, const std::string& config_path,
+                          const SessionConfig& config) {
+    struct stat source;
+    if (!stat_source(config_path, source)) {
+        return false;
+    }
+
+    StringPool pool;
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.source_size = static_cast<uint64_t>(source.st_size);
+    header.source_mtime_sec = static_cast<int64_t>(source.st_mtim.tv_sec);
+    header.source_mtime_nsec = static_cast<int64_t>(source.st_mtim.tv_nsec);
+    header.app_name = pool.add(config.app_name);
+    header.version_string = pool.add(config.version);
+    header.cache_policy = pool.add(config.cache_policy);
+    header.cache_admission = pool.add(config.cache_admission);
+    header.waveform_format = pool.add(config.waveform_format);
+    header.controller_cache_bytes = config.controller_cache_bytes;
+    header.controller_cache_ceiling = config.controller_cache_ceiling;
+    header.controller_cache_size = config.controller_cache_size;
+    header.prefetch_lookahead = config.prefetch_lookahead;
+    header.library_build_threads = config.library_build_threads;
+    header.default_crossfade_time = config.default_crossfade_time;
+    header.bpm_tolerance = config.bpm_tolerance;
+    header.library_build_log = config.library_build_log ? 1 : 0;
+    header.auto_sync = config.auto_sync ? 1 : 0;
+
+    std::vector<TrackRecord> tracks;
+    std::vector<StringRef> artists;
+    tracks.reserve(config.library_tracks.size());
+    for (const auto& info : config.library_tracks) {
+        TrackRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.type = pool.add(info.type);
+        record.title = pool.append(info.title);
+        record.first_artist = static_cast<uint32_t>(artists.size());
+        record.artist_count = static_cast<uint32_t>(info.artists.size());
+        for (const std::string& artist : info.artists) {
+            artists.push_back(pool.add(artist));
+        }
+        record.duration_seconds = info.duration_seconds;
+        record.bpm = info.bpm;
+        record.extra_param1 = info.extra_param1;
+        record.extra_param2 = info.extra_param2;
+        tracks.push_back(record);
+    }
+
+    std::vector<PlaylistRecord> playlists;
+    std::vector<int32_t> indices;
+    for (const auto& entry : config.playlists) {
+        PlaylistRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.name = pool.add(entry.first);
+        record.first_index = static_cast<uint32_t>(indices.size());
+        record.index_count = static_cast<uint32_t>(entry.second.size());
+        indices.insert(indices.end(), entry.second.begin(), entry.second.end());
+        playlists.push_back(record);
+    }
+
+    if (pool.overflowed() || artists.size() > UINT32_MAX || indices.size() > UINT32_MAX) {
+        return false;
+    }
+
+    std::vector<char> image(sizeof(Header), '\0');
+    header.tracks = {image.size(), tracks.size()};
+    append_records(image, tracks);
+    header.artists = {image.size(), artists.size()};
+    append_records(image, artists);
+    header.playlists = {image.size(), playlists.size()};
+    append_records(image, playlists);
+    header.indices = {image.size(), indices.size()};
+    append_records(image, indices);
+    header.strings = {image.size(), pool.data().size()};
+    image.insert(image.end(), pool.data().begin(), pool.data().end());
+    header.file_size = image.size();
+    std::memcpy(image.data(), &header, sizeof(header));
+
+    // Write beside the target and rename, so readers never see a partial file
+    const std::string temp_path = snapshot_path + ".tmp";
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    out.write(image.data(), static_cast<std::streamsize>(image.size()));
+    out.close();
+    if (!out) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    if (std::rename(temp_path.c_str(), snapshot_path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
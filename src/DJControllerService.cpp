@@ -1,33 +1,327 @@
 #include "DJControllerService.h"
 #include "MP3Track.h"
 #include "WAVTrack.h"
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <chrono>
 
 DJControllerService::DJControllerService(size_t cache_size)
-    : cache(cache_size) {}
+    : cache(cache_size), shared_cache(), pinned(), pending_prefetches(), prefetch_stats(), admission(),
+      admission_stats(), bypass(nullptr), track_keys(), resize_stats(), adaptive_ceiling(0), adaptive_window(16),
+      window_loads(0), window_hits(0), last_window_rate(-1.0), growing(true) {}
 /**
- * TODO: Implement loadTrackToCache method
+ * @brief Ensure a track is cached: HIT refreshes MRU, MISS clones, prepares and inserts
+ * @return 1 on HIT, 0 on MISS without eviction, -1 on MISS with eviction
  */
 int DJControllerService::loadTrackToCache(AudioTrack& track) {
-    // Your implementation here 
-    return 0; // Placeholder
+    const std::string& title = track.get_title();
+    const TrackId id = track.get_id();
+    if (id != 0) {
+        if (id >= track_keys.size()) {
+            track_keys.resize(id + 1);
+        }
+        track_keys[id] = track.get_title_id();
+    }
+    if (shared_cache) {
+        return loadTrackToSharedCache(track, title);
+    }
+    const int result = loadTrackToPrivateCache(track, title);
+    if (adaptive_ceiling > 0) {
+        adaptCapacity(result == 1);
+    }
+    return result;
+}
+
+int DJControllerService::loadTrackToPrivateCache(AudioTrack& track, const std::string& title) {
+    bypass = nullptr;
+    const InternedString key = track.get_title_id();
+    if (admission) {
+        admission->record(key);
+    }
+    if (cache.get(key)) {
+        std::cout << "[Cache HIT] " << title << " found in cache. Refreshing MRU state.\n";
+        for (auto it = pending_prefetches.begin(); it != pending_prefetches.end(); ++it) {
+            if (it->first == key) {
+                prefetch_stats.hits++;
+                prefetch_stats.stall_avoided_ms += it->second;
+                pending_prefetches.erase(it);
+                break;
+            }
+        }
+        return 1;
+    }
+
+    if (admission) {
+        // Decide before cloning, so a rejected track costs no copy or load
+        InternedString victim;
+        if (cache.victimFor(track, victim)) {
+            if (!admission->admit(key, victim)) {
+                std::cout << "[Cache REJECT] '" << title << "' is requested less often than '" << victim
+                          << "'; playing it uncached.\n";
+                admission_stats.rejected++;
+                bypass = &track;
+                return 0;
+            }
+            admission_stats.admitted++;
+        }
+    }
+
+    std::cout << "[Cache MISS] Cloning track into cache: " << title << "\n";
+    PointerWrapper<AudioTrack> cloned = track.clone();
+    if (!cloned) {
+        std::cerr << "[ERROR] Track: \"" << title << "\" failed to clone\n";
+        return 0;
+    }
+    cloned->load();
+    cloned->analyze_beatgrid();
+
+    bool evicted = cache.put(std::move(cloned));
+    std::cout << "[Cache INSERT] Added '" << title << "' to cache.\n";
+    if (evicted) {
+        std::cout << "[Cache EVICTION] An item was evicted to make space.\n";
+        collectWastedPrefetches();
+        return -1;
+    }
+    return 0;
+}
+
+int DJControllerService::loadTrackToSharedCache(AudioTrack& track, const std::string& title) {
+    pinned = shared_cache->get(title);
+    if (pinned) {
+        std::cout << "[Cache HIT] " << title << " found in shared cache.\n";
+        return 1;
+    }
+
+    // Another controller may insert the same track meanwhile; put() then replaces it
+    pinned.reset();
+    std::cout << "[Cache MISS] Cloning track into shared cache: " << title << "\n";
+    PointerWrapper<AudioTrack> cloned = track.clone();
+    if (!cloned) {
+        std::cerr << "[ERROR] Track: \"" << title << "\" failed to clone\n";
+        return 0;
+    }
+    cloned->load();
+    cloned->analyze_beatgrid();
+
+    bool evicted = shared_cache->put(std::move(cloned));
+    std::cout << "[Cache INSERT] Added '" << title << "' to shared cache.\n";
+    if (evicted) {
+        std::cout << "[Cache EVICTION] An item was evicted to make space.\n";
+        return -1;
+    }
+    return 0;
+}
+
+bool DJControllerService::prefetchTrack(AudioTrack& track) {
+    const std::string& title = track.get_title();
+    const InternedString key = track.get_title_id();
+    if (cache.contains(key)) {
+        return false;
+    }
+    if (!cache.admitsPrefetch(title)) {
+        std::cout << "[Prefetch SKIP] '" << title << "' is needed later than every cached track.\n";
+        return false;
+    }
+
+    std::cout << "[Prefetch] Loading '" << title << "' ahead of playback.\n";
+    auto start = std::chrono::steady_clock::now();
+    PointerWrapper<AudioTrack> cloned = track.clone();
+    if (!cloned) {
+        std::cerr << "[ERROR] Track: \"" << title << "\" failed to clone\n";
+        return false;
+    }
+    cloned->load();
+    cloned->analyze_beatgrid();
+    std::chrono::duration<double, std::milli> load_time = std::chrono::steady_clock::now() - start;
+
+    bool evicted = cache.put(std::move(cloned));
+    pending_prefetches.push_back(std::make_pair(key, load_time.count()));
+    prefetch_stats.issued++;
+    if (evicted) {
+        std::cout << "[Cache EVICTION] An item was evicted to make space.\n";
+        collectWastedPrefetches();
+    }
+    return true;
+}
+
+void DJControllerService::planAccesses(const std::vector<std::string>& track_titles) {
+    cache.plan(track_titles);
+}
+
+void DJControllerService::advanceTo(size_t position) {
+    cache.advance(position);
+}
+
+void DJControllerService::collectWastedPrefetches() {
+    // At most one prefetch window of entries, so a sweep per eviction stays cheap
+    for (auto it = pending_prefetches.begin(); it != pending_prefetches.end();) {
+        if (!cache.contains(it->first)) {
+            prefetch_stats.wasted++;
+            it = pending_prefetches.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 void DJControllerService::set_cache_size(size_t new_size) {
     cache.set_capacity(new_size);
+    if (admission) {
+        admission->resize(new_size);
+    }
+    collectWastedPrefetches();
+}
+
+std::vector<std::string> DJControllerService::resize_cache(size_t new_size) {
+    const size_t old_size = cache.capacity();
+    std::vector<std::string> evicted = cache.set_capacity(new_size);
+    if (new_size == old_size) {
+        return evicted;
+    }
+    std::cout << "[Cache RESIZE] " << old_size << " -> " << new_size << " slots.\n";
+    if (admission) {
+        // Aging sample and counter width follow the capacity the filter guards
+        admission->resize(new_size);
+    }
+    for (const std::string& title : evicted) {
+        std::cout << "[Cache EVICTION] '" << title << "' evicted to fit the smaller cache.\n";
+    }
+    if (new_size > old_size) {
+        resize_stats.grown++;
+    } else {
+        resize_stats.shrunk++;
+    }
+    resize_stats.evicted += evicted.size();
+    collectWastedPrefetches();
+    return evicted;
+}
+
+void DJControllerService::set_adaptive_sizing(size_t memory_ceiling, size_t window) {
+    adaptive_ceiling = memory_ceiling;
+    adaptive_window = std::max<size_t>(window, 1);
+    window_loads = 0;
+    window_hits = 0;
+    last_window_rate = -1.0;
+    growing = true;
+}
+
+void DJControllerService::adaptCapacity(bool hit) {
+    ++window_loads;
+    if (hit) ++window_hits;
+    if (window_loads < std::max(adaptive_window, 4 * cache.capacity())) {
+        return;
+    }
+    const size_t sampled = window_loads;
+    const double rate = static_cast<double>(window_hits) / static_cast<double>(window_loads);
+    window_loads = 0;
+    window_hits = 0;
+    // Hill climbing: a falling rate means the last step hurt; a flat one means it bought nothing
+    if (last_window_rate >= 0.0) {
+        if (rate < last_window_rate) {
+            growing = !growing;
+        } else if (rate == last_window_rate) {
+            growing = false;
+        }
+    }
+    const double previous = last_window_rate;
+    last_window_rate = rate;
+
+    const size_t current = cache.capacity();
+    const size_t step = std::max<size_t>(1, current / 4);
+    size_t target = growing ? current + step : (current > step ? current - step : 1);
+    if (cache.size() > 0) {
+        // Slots the ceiling affords at the cached tracks' mean footprint
+        const size_t per_track = std::max<size_t>(1, cache.memory_used() / cache.size());
+        target = std::min(target, std::max<size_t>(1, adaptive_ceiling / per_track));
+    }
+    if (target == current) {
+        return;
+    }
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1) << "[Cache ADAPT] Hit rate " << 100.0 * rate << "%";
+    if (previous >= 0.0) {
+        line << " (was " << 100.0 * previous << "%)";
+    }
+    line << " over the last " << sampled << " loads; "
+         << (target > current ? "growing" : "shrinking") << " the cache.\n";
+    std::cout << line.str();
+    resize_cache(target);
+}
+
+void DJControllerService::set_cache_bytes(size_t bytes) {
+    cache.set_byte_budget(bytes);
+    collectWastedPrefetches();
+}
+
+bool DJControllerService::set_cache_policy(const std::string& policy_name) {
+    PointerWrapper<EvictionPolicy> policy = EvictionPolicy::create(policy_name);
+    if (!policy) {
+        return false;
+    }
+    cache.set_policy(std::move(policy));
+    return true;
+}
+
+bool DJControllerService::set_cache_admission(const std::string& filter_name) {
+    if (filter_name == "none") {
+        admission = PointerWrapper<TinyLFU>();
+    } else if (filter_name == "tinylfu") {
+        admission = PointerWrapper<TinyLFU>(new TinyLFU(cache.capacity()));
+    } else {
+        return false;
+    }
+    bypass = nullptr;
+    return true;
 }
 //implemented
 void DJControllerService::displayCacheStatus() const {
     std::cout << "\n=== Cache Status ===\n";
-    cache.displayStatus();
+    if (shared_cache) {
+        shared_cache->displayStatus();
+    } else {
+        cache.displayStatus();
+    }
     std::cout << "====================\n";
 }
 
-/**
- * TODO: Implement getTrackFromCache method
- */
 AudioTrack* DJControllerService::getTrackFromCache(const std::string& track_title) {
-    // Your implementation here
-    return nullptr; // Placeholder
+    if (shared_cache) {
+        // A HIT in loadTrackToCache pinned the track already; a MISS is looked up uncounted
+        if (!pinned || pinned->get_title() != track_title) {
+            pinned = shared_cache->peek(track_title);
+        }
+        return pinned.get();
+    }
+    // loadTrackToCache already counted this access; peek so the policy sees it once
+    AudioTrack* cached = cache.peek(track_title);
+    if (!cached && bypass && bypass->get_title() == track_title) {
+        return bypass;
+    }
+    return cached;
+}
+
+AudioTrack* DJControllerService::getTrackFromCache(TrackId track_id) {
+    if (track_id == 0 || track_id >= track_keys.size()) {
+        return nullptr;
+    }
+    const InternedString key = track_keys[track_id];
+    if (shared_cache) {
+        if (!pinned || pinned->get_title_id() != key) {
+            pinned = shared_cache->peek(key.str());
+        }
+        return pinned.get();
+    }
+    AudioTrack* cached = cache.peek(key);
+    if (!cached && bypass && bypass->get_id() == track_id) {
+        return bypass;
+    }
+    return cached;
+}
+
+void DJControllerService::set_shared_cache(const std::shared_ptr<ShardedCache>& shared) {
+    shared_cache = shared;
+    pinned.reset();
 }
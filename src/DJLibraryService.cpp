@@ -2,20 +2,243 @@
 #include "SessionFileParser.h"
 #include "MP3Track.h"
 #include "WAVTrack.h"
+#include <algorithm>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <system_error>
+#include <thread>
 #include <filesystem>
 
 
 DJLibraryService::DJLibraryService(const Playlist& playlist) 
-    : playlist(playlist) {}
+    : playlist(playlist), playlists(), current(&this->playlist), prepared(), library(), by_id(), library_index(),
+      artist_index(), bpm_index(), metadata(), build_threads(1), build_logging(true) {}
+
+DJLibraryService::~DJLibraryService() {
+    for (AudioTrack* track : library) {
+        delete track;
+    }
+    library.clear();
+    by_id.clear();
+    playlists.clear();
+    prepared.clear();
+    library_index.clear();
+    artist_index.clear();
+    bpm_index.clear();
+    metadata.clear();
+}
+
+namespace {
+
+// Below this many tracks per worker, starting threads costs more than it saves
+const size_t MIN_TRACKS_PER_WORKER = 4096;
+
+// nullptr for an unknown type
+AudioTrack* make_track(const SessionConfig::TrackInfo& info) {
+    if (info.type == "MP3") {
+        return new MP3Track(info.title, info.artists, info.duration_seconds, info.bpm,
+                            info.extra_param1, info.extra_param2 != 0);
+    }
+    if (info.type == "WAV") {
+        return new WAVTrack(info.title, info.artists, info.duration_seconds, info.bpm,
+                            info.extra_param1, info.extra_param2);
+    }
+    return nullptr;
+}
+
+void warn_unknown_type(const SessionConfig::TrackInfo& info) {
+    std::cerr << "[WARNING] Unknown track type '" << info.type << "' for: " << info.title << "\n";
+}
+
+} // namespace
+
+void DJLibraryService::set_build_threads(size_t threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    build_threads = threads > 0 ? threads : 1;
+}
+
 /**
- * @brief Load a playlist from track indices referencing the library
+ * @brief Build the library from config entries, in parallel when configured
  * @param library_tracks Vector of track info from config
+ * Tracks land at their config position whatever the thread count, so 1-based
+ * indices keep referring to the same entries.
  */
 void DJLibraryService::buildLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks) {
-    //Todo: Implement buildLibrary method
-    std::cout << "TODO: Implement DJLibraryService::buildLibrary method\n"<< library_tracks.size() << " tracks to be loaded into library.\n";
+    std::cout << "[INFO] Building track library from config...\n";
+    const size_t count = library_tracks.size();
+    const size_t workers = std::max<size_t>(1, std::min(build_threads, count / MIN_TRACKS_PER_WORKER));
+    std::vector<AudioTrack*> built(count, nullptr);
+    try {
+        if (workers > 1) {
+            construct_parallel(library_tracks, built, workers);
+        } else {
+            std::ostream discard(nullptr);
+            AudioTrack::set_construction_log(build_logging ? nullptr : &discard);
+            for (size_t i = 0; i < count; ++i) {
+                built[i] = make_track(library_tracks[i]);
+                if (!built[i]) {
+                    warn_unknown_type(library_tracks[i]);
+                }
+            }
+            AudioTrack::set_construction_log(nullptr);
+        }
+    } catch (...) {
+        AudioTrack::set_construction_log(nullptr);
+        for (AudioTrack* track : built) {
+            delete track;
+        }
+        throw;
+    }
+
+    library.reserve(library.size() + count);
+    by_id.reserve(by_id.size() + count);
+    for (AudioTrack* track : built) {
+        // Skipped entries keep their number, so later ids still match library_track_N
+        by_id.push_back(track);
+        if (track) {
+            library.push_back(track);
+            track->set_id(static_cast<TrackId>(by_id.size()));
+        }
+    }
+    index_tracks(built, library_tracks, workers > 1);
+    std::cout << "[INFO] Track library built: " << library.size() << " tracks loaded\n";
+}
+
+void DJLibraryService::construct_parallel(const std::vector<SessionConfig::TrackInfo>& library_tracks,
+                                          std::vector<AudioTrack*>& built, size_t workers) {
+    // Contiguous chunks, each logging into its own buffer; printed in chunk
+    // order afterwards, the output matches a serial build line for line
+    // (warnings for a chunk follow its construction lines)
+    const size_t count = library_tracks.size();
+    const size_t chunk = (count + workers - 1) / workers;
+    std::vector<std::ostringstream> logs(workers);
+    std::vector<std::vector<size_t> > unknown(workers);
+    std::vector<std::exception_ptr> errors(workers);
+
+    auto work = [&](size_t worker) {
+        std::ostream discard(nullptr);
+        AudioTrack::set_construction_log(build_logging ? static_cast<std::ostream*>(&logs[worker]) : &discard);
+        try {
+            const size_t end = std::min(count, (worker + 1) * chunk);
+            for (size_t i = worker * chunk; i < end; ++i) {
+                built[i] = make_track(library_tracks[i]);
+                if (!built[i]) {
+                    unknown[worker].push_back(i);
+                }
+            }
+        } catch (...) {
+            errors[worker] = std::current_exception();
+        }
+        AudioTrack::set_construction_log(nullptr);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t worker = 1; worker < workers; ++worker) {
+        try {
+            threads.emplace_back(work, worker);
+        } catch (const std::system_error&) {
+            work(worker);  // Out of threads: this chunk runs here instead
+        }
+    }
+    work(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t worker = 0; worker < workers; ++worker) {
+        if (errors[worker]) {
+            std::rethrow_exception(errors[worker]);
+        }
+    }
+    for (size_t worker = 0; worker < workers; ++worker) {
+        std::cout << logs[worker].str();
+        for (size_t i : unknown[worker]) {
+            warn_unknown_type(library_tracks[i]);
+        }
+    }
+}
+
+void DJLibraryService::index_tracks(const std::vector<AudioTrack*>& built,
+                                    const std::vector<SessionConfig::TrackInfo>& library_tracks, bool parallel) {
+    // built[i] came from library_tracks[i]; nullptr for entries of unknown type
+    auto index_titles = [&]() {
+        library_index.reserve(library_index.size() + built.size());
+        for (AudioTrack* track : built) {
+            // Duplicate titles keep the first entry, as a front-to-back scan would
+            if (track) {
+                library_index.emplace(track->get_title(), track);
+            }
+        }
+    };
+    auto index_artists = [&]() {
+        for (size_t i = 0; i < built.size(); ++i) {
+            AudioTrack* track = built[i];
+            if (!track) {
+                continue;
+            }
+            for (const std::string& artist : library_tracks[i].artists) {
+                std::vector<AudioTrack*>& credited = artist_index[artist];
+                // An artist listed twice on one entry still indexes the track once
+                if (credited.empty() || credited.back() != track) {
+                    credited.push_back(track);
+                }
+            }
+        }
+    };
+    auto index_bpms = [&]() {
+        const size_t indexed = bpm_index.size();
+        bpm_index.reserve(indexed + built.size());
+        for (AudioTrack* track : built) {
+            if (track) {
+                bpm_index.emplace_back(track->get_bpm(), track);
+            }
+        }
+        // Sort only the new entries and merge them in; stable, so equal BPMs keep library order
+        auto by_bpm = [](const std::pair<int, AudioTrack*>& a, const std::pair<int, AudioTrack*>& b) {
+            return a.first < b.first;
+        };
+        std::stable_sort(bpm_index.begin() + indexed, bpm_index.end(), by_bpm);
+        std::inplace_merge(bpm_index.begin(), bpm_index.begin() + indexed, bpm_index.end(), by_bpm);
+    };
+
+    auto fill_metadata = [&]() {
+        metadata.reserve(metadata.size() + built.size());
+        for (size_t i = 0; i < built.size(); ++i) {
+            const SessionConfig::TrackInfo& info = library_tracks[i];
+            TrackFormat format;
+            if (built[i] && TrackMetadataTable::parse_format(info.type, format)) {
+                metadata.append(format, info.duration_seconds, info.bpm, info.extra_param1, info.extra_param2);
+            }
+        }
+    };
+
+    if (!parallel) {
+        index_titles();
+        index_artists();
+        index_bpms();
+        fill_metadata();
+        return;
+    }
+    // The indexes and the table share no state, so each gets its own thread
+    const std::function<void()> tasks[] = {index_titles, index_bpms, fill_metadata};
+    std::vector<std::thread> threads;
+    for (const std::function<void()>& task : tasks) {
+        try {
+            threads.emplace_back(task);
+        } catch (const std::system_error&) {
+            task();  // Out of threads: run it here instead
+        }
+    }
+    index_artists();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
 }
 
 /**
@@ -24,17 +247,17 @@ void DJLibraryService::buildLibrary(const std::vector<SessionConfig::TrackInfo>&
  */
 void DJLibraryService::displayLibrary() const {
     std::cout << "=== DJ Library Playlist: " 
-              << playlist.get_name() << " ===" << std::endl;
+              << current->get_name() << " ===" << std::endl;
 
-    if (playlist.is_empty()) {
+    if (current->is_empty()) {
         std::cout << "[INFO] Playlist is empty.\n";
         return;
     }
 
     // Let Playlist handle printing all track info
-    playlist.display();
+    current->display();
 
-    std::cout << "Total duration: " << playlist.get_total_duration() << " seconds" << std::endl;
+    std::cout << "Total duration: " << current->get_total_duration() << " seconds" << std::endl;
 }
 
 /**
@@ -43,32 +266,145 @@ void DJLibraryService::displayLibrary() const {
  * @return Playlist& 
  */
 Playlist& DJLibraryService::getPlaylist() {
-    // Your implementation here
-    return playlist;
+    return *current;
 }
 
-/**
- * TODO: Implement findTrack method
- * 
- * HINT: Leverage Playlist's find_track method
- */
 AudioTrack* DJLibraryService::findTrack(const std::string& track_title) {
-    // Your implementation here
-    return nullptr; // Placeholder
+    AudioTrack* track = current->find_track(track_title);
+    return track ? track : findLibraryTrack(track_title);
+}
+
+AudioTrack* DJLibraryService::findLibraryTrack(const std::string& track_title) const {
+    auto entry = library_index.find(track_title);
+    return entry == library_index.end() ? nullptr : entry->second;
+}
+
+const std::vector<AudioTrack*>& DJLibraryService::findTracksByArtist(const std::string& artist) const {
+    static const std::vector<AudioTrack*> none;
+    auto entry = artist_index.find(artist);
+    return entry == artist_index.end() ? none : entry->second;
 }
 
+std::vector<AudioTrack*> DJLibraryService::findTracksByBpm(int bpm, int tolerance) const {
+    std::vector<AudioTrack*> matches;
+    if (tolerance < 0) {
+        return matches;
+    }
+    // Bounds in long long so extreme tolerances cannot overflow
+    const long long low = static_cast<long long>(bpm) - tolerance;
+    const long long high = static_cast<long long>(bpm) + tolerance;
+    auto first = std::lower_bound(bpm_index.begin(), bpm_index.end(), low,
+                                  [](const std::pair<int, AudioTrack*>& entry, long long value) {
+                                      return entry.first < value;
+                                  });
+    auto last = std::upper_bound(first, bpm_index.end(), high,
+                                 [](long long value, const std::pair<int, AudioTrack*>& entry) {
+                                     return value < entry.first;
+                                 });
+    matches.reserve(static_cast<size_t>(last - first));
+    for (; first != last; ++first) {
+        matches.push_back(first->second);
+    }
+    return matches;
+}
+
+/**
+ * @brief Replace the current playlist with handles to the referenced library tracks
+ * The playlist borrows the library's instances, so repeated indices and
+ * tracks shared with other playlists cost a node each, not a copy. Each
+ * track is prepared (load + beatgrid analysis) before it is added; analysis
+ * results are memoised on the instance, so repeats reuse them.
+ */
 void DJLibraryService::loadPlaylistFromIndices(const std::string& playlist_name, 
                                                const std::vector<int>& track_indices) {
-    // Your implementation here
-    // For now, add a placeholder to fix the linker error
-    (void)playlist_name;  // Suppress unused parameter warning
-    (void)track_indices;  // Suppress unused parameter warning
+    std::cout << "[INFO] Loading playlist: " << playlist_name << "\n";
+    playlist = Playlist(playlist_name, false);
+    current = &playlist;
+
+    for (int index : track_indices) {
+        if (index < 1 || static_cast<size_t>(index) > library.size()) {
+            std::cout << "[WARNING] Invalid track index: " << index << "\n";
+            continue;
+        }
+        AudioTrack* track = library[index - 1];
+        track->load();
+        track->analyze_beatgrid();
+        playlist.add_track(track);
+    }
+    std::cout << "[INFO] Playlist loaded: " << playlist_name
+              << " (" << playlist.get_track_count() << " tracks)\n";
 }
+
+void DJLibraryService::loadPlaylists(const std::map<std::string, std::vector<int> >& configured,
+                                     bool prepare_tracks) {
+    current = &playlist;
+    playlists.clear();
+    playlists.reserve(configured.size());
+    prepared.resize(library.size(), false);
+    size_t entries = 0;
+
+    for (const auto& entry : configured) {
+        std::cout << "[INFO] Loading playlist: " << entry.first << "\n";
+        Playlist& loaded = playlists.emplace(entry.first, Playlist(entry.first, false)).first->second;
+        for (int index : entry.second) {
+            if (index < 1 || static_cast<size_t>(index) > library.size()) {
+                std::cout << "[WARNING] Invalid track index: " << index << "\n";
+                continue;
+            }
+            AudioTrack* track = library[index - 1];
+            if (prepare_tracks && !prepared[index - 1]) {
+                track->load();
+                track->analyze_beatgrid();
+                prepared[index - 1] = true;
+            }
+            loaded.add_track(track);
+        }
+        entries += static_cast<size_t>(loaded.get_track_count());
+        std::cout << "[INFO] Playlist loaded: " << entry.first
+                  << " (" << loaded.get_track_count() << " tracks)\n";
+    }
+    std::cout << "[INFO] Playlists resolved: " << playlists.size() << " playlists, "
+              << entries << " entries\n";
+}
+
+bool DJLibraryService::selectPlaylist(const std::string& playlist_name) {
+    auto entry = playlists.find(playlist_name);
+    if (entry == playlists.end()) {
+        return false;
+    }
+    current = &entry->second;
+    return true;
+}
+
+const Playlist* DJLibraryService::findPlaylist(const std::string& playlist_name) const {
+    auto entry = playlists.find(playlist_name);
+    return entry == playlists.end() ? nullptr : &entry->second;
+}
+
+AudioTrack* DJLibraryService::getTrack(TrackId track_id) const {
+    if (track_id == 0 || track_id > by_id.size()) {
+        return nullptr;
+    }
+    return by_id[track_id - 1];
+}
+
+std::vector<TrackId> DJLibraryService::getTrackIds() const {
+    std::vector<TrackId> ids;
+    ids.reserve(static_cast<size_t>(current->get_track_count()));
+    for (AudioTrack* track : *current) {
+        ids.push_back(track->get_id());
+    }
+    return ids;
+}
+
 /**
- * TODO: Implement getTrackTitles method
- * @return Vector of track titles in the playlist
+ * @return Vector of track titles in the current playlist
  */
 std::vector<std::string> DJLibraryService::getTrackTitles() const {
-    // Your implementation here
-    return std::vector<std::string>(); // Placeholder
+    std::vector<std::string> titles;
+    titles.reserve(static_cast<size_t>(current->get_track_count()));
+    for (AudioTrack* track : *current) {
+        titles.push_back(track->get_title());
+    }
+    return titles;
 }
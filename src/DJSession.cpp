@@ -1,6 +1,11 @@
 
 #include "DJSession.h"
+#include "ConfigSnapshot.h"
+#include "MissRatioCurve.h"
+#include "WaveformBuffer.h"
 #include <iostream>
+#include <iomanip>
+#include <fstream>
 #include <algorithm>
 #include <sstream>
 #include <dirent.h>
@@ -20,63 +25,130 @@ DJSession::~DJSession() {
 
 // ========== CORE FUNCTIONALITY ==========
 bool DJSession::load_playlist(const std::string& playlist_name)  {
-    std::cout << "[System] Loading playlist: " << playlist_name << "\n";
+    std::cout << "[System] Switching to playlist: " << playlist_name << "\n";
     
-    // Find the playlist in the session config
-    auto it = session_config.playlists.find(playlist_name);
-    if (it == session_config.playlists.end()) {
+    // Playlists were resolved when the library was built
+    if (!library_service.selectPlaylist(playlist_name)) {
         std::cerr << "[ERROR] Playlist '" << playlist_name << "' not found in configuration.\n";
         return false;
     }
     
-    // Load playlist from track indices
-    library_service.loadPlaylistFromIndices(playlist_name, it->second);
-    
     if (library_service.getPlaylist().is_empty()) {
         return false;
     }
     
     track_titles = library_service.getTrackTitles();
+    track_ids = library_service.getTrackIds();
+    controller_service.planAccesses(track_titles);
     return true;
 }
 
 /**
- * TODO: Implement load_track_to_controller method
- * 
- * REQUIREMENTS:
- * 1. Track Retrieval
- *    - Find track in library using track name
- *    - Handle case when track is not found
- *    - Update error stats if track not found
- * 
- * 2. Controller Loading
- *    - Delegate loading to controller_service
- *    - Pass track by reference to controller
- * 
- * 3. Return Values
+ * Return Values
  *    1: Cache HIT
  *    0: Cache MISS (or error)
  *   -1: Cache MISS with eviction
  * 
  * @param track_name: Name of track to load
  * @return: Cache operation result code
-
  */
 int DJSession::load_track_to_controller(const std::string& track_name) {
-    // Your implementation here
-    return 0; // Placeholder
+    AudioTrack* track = library_service.findTrack(track_name);
+    if (!track) {
+        std::cerr << "[ERROR] Track: \"" << track_name << "\" not found in library\n";
+        stats.errors++;
+        return 0;
+    }
+    return load_library_track_to_controller(*track);
+}
+
+int DJSession::load_track_to_controller(TrackId track_id) {
+    AudioTrack* track = library_service.getTrack(track_id);
+    if (!track) {
+        std::cerr << "[ERROR] Track: #" << track_id << " not found in library\n";
+        stats.errors++;
+        return 0;
+    }
+    return load_library_track_to_controller(*track);
+}
+
+int DJSession::load_library_track_to_controller(AudioTrack& track) {
+    std::cout << "[System] Loading track '" << track.get_title() << "' to controller...\n";
+    int result = controller_service.loadTrackToCache(track);
+    if (result == 1) {
+        stats.cache_hits++;
+    } else {
+        stats.cache_misses++;
+        if (result == -1) {
+            stats.cache_evictions++;
+        }
+    }
+    const DJControllerService::AdmissionStats& admission = controller_service.get_admission_stats();
+    stats.admissions = admission.admitted;
+    stats.rejections = admission.rejected;
+    return result;
 }
 
 /**
- * TODO: Implement load_track_to_mixer_deck method
- * 
  * @param track_title: Title of track to load to mixer
  * @return: Whether track was successfully loaded to a deck
  */
 bool DJSession::load_track_to_mixer_deck(const std::string& track_title) {
     std::cout << "[System] Delegating track transfer to MixingEngineService for: " << track_title << std::endl;
-    // your implementation here
-    return false; // Placeholder
+    return load_cached_track_to_mixer_deck(track_title, controller_service.getTrackFromCache(track_title));
+}
+
+bool DJSession::load_track_to_mixer_deck(TrackId track_id) {
+    AudioTrack* library_track = library_service.getTrack(track_id);
+    if (!library_track) {
+        std::cerr << "[ERROR] Track: #" << track_id << " not found in library\n";
+        stats.errors++;
+        return false;
+    }
+    const std::string& track_title = library_track->get_title();
+    std::cout << "[System] Delegating track transfer to MixingEngineService for: " << track_title << std::endl;
+    return load_cached_track_to_mixer_deck(track_title, controller_service.getTrackFromCache(track_id));
+}
+
+bool DJSession::load_cached_track_to_mixer_deck(const std::string& track_title, AudioTrack* track) {
+    if (!track) {
+        std::cerr << "[ERROR] Track: \"" << track_title << "\" not found in cache\n";
+        stats.errors++;
+        return false;
+    }
+
+    int deck = mixing_service.loadTrackToDeck(*track);
+    if (deck == 0) {
+        stats.deck_loads_a++;
+    } else if (deck == 1) {
+        stats.deck_loads_b++;
+    } else {
+        std::cerr << "[ERROR] Failed to load '" << track_title << "' to a deck\n";
+        stats.errors++;
+        return false;
+    }
+    stats.transitions++;
+    return true;
+}
+
+void DJSession::prefetch_upcoming_tracks(size_t position) {
+    if (session_config.prefetch_lookahead <= 0) {
+        return;
+    }
+    size_t last = std::min(track_titles.size(),
+                           position + 1 + static_cast<size_t>(session_config.prefetch_lookahead));
+    for (size_t i = position + 1; i < last; ++i) {
+        AudioTrack* track = library_service.getTrack(track_ids[i]);
+        if (track) {
+            controller_service.prefetchTrack(*track);
+        }
+    }
+
+    const DJControllerService::PrefetchStats& prefetch = controller_service.get_prefetch_stats();
+    stats.prefetches_issued = prefetch.issued;
+    stats.prefetch_hits = prefetch.hits;
+    stats.prefetches_wasted = prefetch.wasted;
+    stats.stall_avoided_ms = prefetch.stall_avoided_ms;
 }
 
 /**
@@ -94,24 +166,131 @@ void DJSession::simulate_dj_performance() {
     }
     
     // 2. Build track library from config
+    const int threads = session_config.library_build_threads;
+    library_service.set_build_threads(threads < 0 ? 1 : static_cast<size_t>(threads));
+    library_service.set_build_logging(session_config.library_build_log);
     library_service.buildLibrary(session_config.library_tracks);
     
-    // 3. Get available playlists from config
+    // 3. Get available playlists from config and resolve them all once
     if (session_config.playlists.empty()) {
         std::cerr << "[ERROR] No playlists found in configuration. Aborting session." << std::endl;
         return;
     }
+    library_service.loadPlaylists(session_config.playlists);
     std::cout << "\nStarting DJ performance simulation..." << std::endl;
     std::cout << "BPM Tolerance: " << session_config.bpm_tolerance << " BPM" << std::endl;
     std::cout << "Auto Sync: " << (session_config.auto_sync ? "enabled" : "disabled") << std::endl;
-    std::cout << "Cache Capacity: " << session_config.controller_cache_size << " slots (LRU policy)" << std::endl;
+    if (session_config.controller_cache_bytes > 0) {
+        std::cout << "Cache Capacity: " << session_config.controller_cache_bytes << " bytes ("
+                  << stats.cache_policy << " policy)" << std::endl;
+    } else {
+        std::cout << "Cache Capacity: " << session_config.controller_cache_size << " slots ("
+                  << stats.cache_policy << " policy)" << std::endl;
+    }
     std::cout << "\n--- Processing Tracks ---" << std::endl;
 
-    std::cout << "TODO: Implement the DJ performance simulation workflow here." << std::endl;
-    // Your implementation here
+    // play_all walks every configured playlist in name order; otherwise ask the user
+    std::vector<std::string> queued;
+    if (play_all) {
+        for (const auto& pair : session_config.playlists) {
+            queued.push_back(pair.first);
+        }
+    }
+    size_t next_queued = 0;
+
+    while (true) {
+        std::string playlist_name;
+        if (play_all) {
+            if (next_queued == queued.size()) break;
+            playlist_name = queued[next_queued++];
+        } else {
+            playlist_name = display_playlist_menu_from_config();
+            if (playlist_name.empty()) break;
+        }
+
+        if (!load_playlist(playlist_name)) {
+            std::cerr << "[ERROR] Could not load playlist '" << playlist_name << "'." << std::endl;
+            continue;
+        }
+
+        const SessionStats before = stats;
+        for (size_t i = 0; i < track_titles.size(); ++i) {
+            const std::string& title = track_titles[i];
+            std::cout << "\n--- Processing: " << title << " ---" << std::endl;
+            stats.tracks_processed++;
+            controller_service.advanceTo(i);
+            load_track_to_controller(track_ids[i]);
+            controller_service.displayCacheStatus();
+            load_track_to_mixer_deck(track_ids[i]);
+            mixing_service.displayDeckStatus();
+            prefetch_upcoming_tracks(i);
+        }
+        record_playlist_stats(playlist_name, before);
+        print_session_summary();
+    }
+    std::cout << "Session cancelled by user or all playlists played." << std::endl;
 }
 
 
+bool DJSession::analyze_cache_sizing(const std::string& export_path) {
+    std::cout << "=== Cache Sizing Analysis (LRU miss-ratio curve) ===" << std::endl;
+    if (!load_configuration()) {
+        std::cerr << "[ERROR] Failed to load configuration. Aborting analysis." << std::endl;
+        return false;
+    }
+
+    std::ofstream csv;
+    if (!export_path.empty()) {
+        csv.open(export_path);
+        if (!csv.is_open()) {
+            std::cerr << "[ERROR] Cannot open export file: " << export_path << std::endl;
+            return false;
+        }
+        csv << "playlist,capacity,hits,accesses,hit_rate\n";
+    }
+
+    // Resolve playlists as the session does, so each trace is the order it plays them in
+    library_service.set_build_logging(false);
+    library_service.buildLibrary(session_config.library_tracks);
+    library_service.loadPlaylists(session_config.playlists, false);
+    std::vector<std::pair<std::string, std::vector<std::string> > > traces;
+    std::vector<std::string> play_all_trace;
+    for (const auto& pair : session_config.playlists) {
+        library_service.selectPlaylist(pair.first);
+        const std::vector<std::string> trace = library_service.getTrackTitles();
+        play_all_trace.insert(play_all_trace.end(), trace.begin(), trace.end());
+        traces.push_back(std::make_pair(pair.first, trace));
+    }
+    if (traces.size() > 1) {
+        traces.push_back(std::make_pair(std::string("<play_all>"), play_all_trace));
+    }
+
+    const size_t configured = static_cast<size_t>(std::max(0, session_config.controller_cache_size));
+    for (const auto& entry : traces) {
+        MissRatioCurve curve(entry.second);
+        std::cout << "\nPlaylist: " << entry.first << " (" << curve.accesses() << " accesses, "
+                  << curve.distinct() << " distinct tracks)" << std::endl;
+        std::cout << "  Capacity  Hit rate  Hits" << std::endl;
+        for (size_t capacity = 1; capacity <= curve.distinct(); ++capacity) {
+            std::cout << "  " << std::setw(8) << capacity << "  "
+                      << std::setw(7) << std::fixed << std::setprecision(2)
+                      << 100.0 * curve.hit_rate(capacity) << "%  " << curve.hits(capacity)
+                      << (capacity == configured ? "  <- controller_cache_size" : "") << std::endl;
+            if (csv.is_open()) {
+                csv << entry.first << "," << capacity << "," << curve.hits(capacity) << ","
+                    << curve.accesses() << "," << curve.hit_rate(capacity) << "\n";
+            }
+        }
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << std::setprecision(6);
+    }
+
+    if (csv.is_open()) {
+        std::cout << "\nCurves exported to: " << export_path << std::endl;
+    }
+    return true;
+}
+
 /* 
  * Helper method to load session configuration from file
  * 
@@ -122,7 +301,15 @@ bool DJSession::load_configuration() {
     
     std::cout << "Loading configuration from: " << config_path << std::endl;
     
-    if (!SessionFileParser::parse_config_file(config_path, session_config)) {
+    // A snapshot still matching the text file replaces parsing; otherwise
+    // parse and (best effort) leave a fresh snapshot for the next start
+    const std::string snapshot_path = ConfigSnapshot::path_for(config_path);
+    if (ConfigSnapshot::load(snapshot_path, config_path, session_config)) {
+        std::cout << "Parsed config file: " << session_config.library_tracks.size() << " tracks found, "
+                  << session_config.playlists.size() << " playlists found" << std::endl;
+    } else if (SessionFileParser::parse_config_file(config_path, session_config)) {
+        ConfigSnapshot::save(snapshot_path, config_path, session_config);
+    } else {
         std::cerr << "[ERROR] Failed to parse configuration file: " << config_path << std::endl;
         return false;
     }
@@ -130,11 +317,45 @@ bool DJSession::load_configuration() {
     std::cout << "Configuration loaded successfully." << std::endl;
     std::cout << "BPM Tolerance: " << session_config.bpm_tolerance << " BPM" << std::endl;
     std::cout << "Auto Sync: " << (session_config.auto_sync ? "enabled" : "disabled") << std::endl;
-    std::cout << "Cache Size: " << session_config.controller_cache_size << " slots" << std::endl;
+    if (session_config.controller_cache_bytes > 0) {
+        std::cout << "Cache Size: " << session_config.controller_cache_bytes << " bytes" << std::endl;
+    } else {
+        std::cout << "Cache Size: " << session_config.controller_cache_size << " slots" << std::endl;
+    }
     mixing_service.set_auto_sync(session_config.auto_sync);
     mixing_service.set_bpm_tolerance(session_config.bpm_tolerance);
     //update cache size in LRUCache
     controller_service.set_cache_size(session_config.controller_cache_size);
+    controller_service.set_cache_bytes(session_config.controller_cache_bytes);
+    if (!controller_service.set_cache_policy(session_config.cache_policy)) {
+        std::cerr << "[WARNING] Unknown cache policy '" << session_config.cache_policy
+                  << "', keeping " << controller_service.get_cache_policy() << std::endl;
+    }
+    if (!controller_service.set_cache_admission(session_config.cache_admission)) {
+        std::cerr << "[WARNING] Unknown cache admission filter '" << session_config.cache_admission
+                  << "', keeping " << controller_service.get_cache_admission() << std::endl;
+    }
+    if (session_config.controller_cache_ceiling > 0) {
+        if (session_config.controller_cache_bytes > 0) {
+            std::cerr << "[WARNING] controller_cache_ceiling ignored: the cache is already limited by "
+                      << "controller_cache_bytes" << std::endl;
+        } else {
+            controller_service.set_adaptive_sizing(session_config.controller_cache_ceiling);
+        }
+    }
+    if (!session_config.waveform_format.empty()) {
+        SampleFormat format;
+        if (WaveformBuffer::parse_format(session_config.waveform_format, format)) {
+            WaveformBuffer::set_default_format(format);
+        } else {
+            std::cerr << "[WARNING] Unknown waveform format '" << session_config.waveform_format
+                      << "', keeping " << WaveformBuffer::format_name(WaveformBuffer::default_format())
+                      << std::endl;
+        }
+    }
+    stats.cache_policy = controller_service.get_cache_policy();
+    std::transform(stats.cache_policy.begin(), stats.cache_policy.end(),
+                   stats.cache_policy.begin(), ::toupper);
     return true;
 }
 
@@ -185,6 +406,25 @@ std::string DJSession::display_playlist_menu_from_config() {
     }
 }
 
+void DJSession::record_playlist_stats(const std::string& playlist_name, const SessionStats& before) {
+    SessionStats& played = playlist_stats[playlist_name];
+    played.cache_policy = stats.cache_policy;
+    played.tracks_processed += stats.tracks_processed - before.tracks_processed;
+    played.cache_hits += stats.cache_hits - before.cache_hits;
+    played.cache_misses += stats.cache_misses - before.cache_misses;
+    played.cache_evictions += stats.cache_evictions - before.cache_evictions;
+    played.deck_loads_a += stats.deck_loads_a - before.deck_loads_a;
+    played.deck_loads_b += stats.deck_loads_b - before.deck_loads_b;
+    played.transitions += stats.transitions - before.transitions;
+    played.errors += stats.errors - before.errors;
+    played.prefetches_issued += stats.prefetches_issued - before.prefetches_issued;
+    played.prefetch_hits += stats.prefetch_hits - before.prefetch_hits;
+    played.prefetches_wasted += stats.prefetches_wasted - before.prefetches_wasted;
+    played.stall_avoided_ms += stats.stall_avoided_ms - before.stall_avoided_ms;
+    played.admissions += stats.admissions - before.admissions;
+    played.rejections += stats.rejections - before.rejections;
+}
+
 void DJSession::print_session_summary() const {
     std::cout << "\n=== DJ Session Summary ===" << std::endl;
     std::cout << "Session: " << session_name << std::endl;
@@ -192,9 +432,53 @@ void DJSession::print_session_summary() const {
     std::cout << "Cache hits: " << stats.cache_hits << std::endl;
     std::cout << "Cache misses: " << stats.cache_misses << std::endl;
     std::cout << "Cache evictions: " << stats.cache_evictions << std::endl;
+    std::cout << "Cache policy: " << stats.cache_policy << std::endl;
+    const size_t lookups = stats.cache_hits + stats.cache_misses;
+    std::ostringstream hit_rate;
+    hit_rate << std::fixed << std::setprecision(1)
+             << (lookups ? 100.0 * stats.cache_hits / lookups : 0.0);
+    std::cout << "Cache hit rate: " << hit_rate.str() << "%" << std::endl;
+    const bool filtered = std::string(controller_service.get_cache_admission()) != "none";
+    if (filtered) {
+        std::cout << "Cache admission: " << controller_service.get_cache_admission() << " ("
+                  << stats.admissions << " admitted, " << stats.rejections << " rejected)" << std::endl;
+    }
+    std::cout << "Cache memory: " << controller_service.get_cache_memory_used() << " bytes (peak "
+              << controller_service.get_cache_memory_peak() << " bytes";
+    if (controller_service.get_cache_bytes() > 0) {
+        std::cout << ", budget " << controller_service.get_cache_bytes() << " bytes";
+    }
+    std::cout << ")" << std::endl;
+    const WaveformBuffer::Stats waveform_stats = WaveformBuffer::stats();
+    std::cout << "Waveform buffers: " << waveform_stats.allocations << " allocated ("
+              << waveform_stats.bytes_allocated << " bytes), " << waveform_stats.shares
+              << " copies shared" << std::endl;
+    if (controller_service.get_adaptive_sizing()) {
+        const DJControllerService::ResizeStats& resizes = controller_service.get_resize_stats();
+        std::cout << "Cache resizes: " << resizes.grown << " grown, " << resizes.shrunk << " shrunk, "
+                  << resizes.evicted << " evicted; now " << controller_service.get_cache_capacity()
+                  << " slots (ceiling " << session_config.controller_cache_ceiling << " bytes)" << std::endl;
+    }
+    if (session_config.prefetch_lookahead > 0) {
+        std::cout << "Prefetches issued: " << stats.prefetches_issued << std::endl;
+        std::cout << "Prefetch hits: " << stats.prefetch_hits << std::endl;
+        std::cout << "Wasted prefetches: " << stats.prefetches_wasted << std::endl;
+        std::cout << "Stall time avoided: " << stats.stall_avoided_ms << " ms" << std::endl;
+    }
     std::cout << "Deck A loads: " << stats.deck_loads_a << std::endl;
     std::cout << "Deck B loads: " << stats.deck_loads_b << std::endl;
     std::cout << "Transitions: " << stats.transitions << std::endl;
     std::cout << "Errors: " << stats.errors << std::endl;
+    for (const auto& entry : playlist_stats) {
+        const SessionStats& played = entry.second;
+        std::cout << "Playlist " << entry.first << ": " << played.tracks_processed << " tracks, "
+                  << played.cache_hits << " hits, " << played.cache_misses << " misses, "
+                  << played.cache_evictions << " evictions, " << played.transitions << " transitions, "
+                  << played.errors << " errors";
+        if (filtered) {
+            std::cout << ", " << played.admissions << " admitted, " << played.rejections << " rejected";
+        }
+        std::cout << std::endl;
+    }
     std::cout << "=== Session Complete ===" << std::endl;
 }
\ No newline at end of file
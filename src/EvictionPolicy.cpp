@@ -0,0 +1,89 @@
+#include "EvictionPolicy.h"
+#include "LRUPolicy.h"
+#include "LFUPolicy.h"
+#include "ClockPolicy.h"
+#include "ARCPolicy.h"
+#include "TwoQPolicy.h"
+#include "BeladyPolicy.h"
+
+// ========== SlotList ==========
+
+void SlotList::pushFront(std::vector<CacheSlot>& slots, size_t idx) {
+    slots[idx].prev = CacheSlot::NIL;
+    slots[idx].next = head_idx;
+    if (head_idx != CacheSlot::NIL) {
+        slots[head_idx].prev = idx;
+    } else {
+        tail_idx = idx;
+    }
+    head_idx = idx;
+    ++length;
+}
+
+void SlotList::remove(std::vector<CacheSlot>& slots, size_t idx) {
+    CacheSlot& slot = slots[idx];
+    if (slot.prev != CacheSlot::NIL) {
+        slots[slot.prev].next = slot.next;
+    } else {
+        head_idx = slot.next;
+    }
+    if (slot.next != CacheSlot::NIL) {
+        slots[slot.next].prev = slot.prev;
+    } else {
+        tail_idx = slot.prev;
+    }
+    slot.prev = slot.next = CacheSlot::NIL;
+    --length;
+}
+
+void SlotList::relink(std::vector<CacheSlot>& slots, size_t from, size_t to) {
+    const CacheSlot& slot = slots[to];
+    if (slot.prev != CacheSlot::NIL) {
+        slots[slot.prev].next = to;
+    } else if (head_idx == from) {
+        head_idx = to;
+    }
+    if (slot.next != CacheSlot::NIL) {
+        slots[slot.next].prev = to;
+    } else if (tail_idx == from) {
+        tail_idx = to;
+    }
+}
+
+// ========== GhostList ==========
+
+void GhostList::pushFront(const std::string& key) {
+    erase(key);
+    order.push_front(key);
+    lookup[key] = order.begin();
+}
+
+void GhostList::erase(const std::string& key) {
+    auto it = lookup.find(key);
+    if (it == lookup.end()) return;
+    order.erase(it->second);
+    lookup.erase(it);
+}
+
+void GhostList::popBack() {
+    if (order.empty()) return;
+    lookup.erase(order.back());
+    order.pop_back();
+}
+
+// ========== EvictionPolicy ==========
+
+void EvictionPolicy::attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) {
+    slots = slot_storage;
+    capacity = cache_capacity;
+}
+
+PointerWrapper<EvictionPolicy> EvictionPolicy::create(const std::string& policy_name) {
+    if (policy_name == "lru") return PointerWrapper<EvictionPolicy>(new LRUPolicy());
+    if (policy_name == "lfu") return PointerWrapper<EvictionPolicy>(new LFUPolicy());
+    if (policy_name == "clock") return PointerWrapper<EvictionPolicy>(new ClockPolicy());
+    if (policy_name == "arc") return PointerWrapper<EvictionPolicy>(new ARCPolicy());
+    if (policy_name == "2q") return PointerWrapper<EvictionPolicy>(new TwoQPolicy());
+    if (policy_name == "belady") return PointerWrapper<EvictionPolicy>(new BeladyPolicy());
+    return PointerWrapper<EvictionPolicy>();
+}
@@ -0,0 +1,66 @@
+#include "FFT.h"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+FFT::FFT(size_t size) : n(size), twiddles(size / 2), bit_reversed(size) {
+    if (n == 0 || (n & (n - 1)) != 0) {
+        throw std::invalid_argument("FFT size must be a power of two");
+    }
+    const double pi = std::acos(-1.0);
+    for (size_t k = 0; k < n / 2; ++k) {
+        const double angle = -2.0 * pi * static_cast<double>(k) / static_cast<double>(n);
+        twiddles[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+    }
+    size_t bits = 0;
+    while ((static_cast<size_t>(1) << bits) < n) ++bits;
+    for (size_t i = 0; i < n; ++i) {
+        size_t reversed = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            if (i & (static_cast<size_t>(1) << b)) reversed |= static_cast<size_t>(1) << (bits - 1 - b);
+        }
+        bit_reversed[i] = reversed;
+    }
+}
+
+void FFT::forward(std::complex<double>* data) const {
+    transform(data, false);
+}
+
+void FFT::inverse(std::complex<double>* data) const {
+    transform(data, true);
+    const double scale = 1.0 / static_cast<double>(n);
+    for (size_t i = 0; i < n; ++i) {
+        data[i] *= scale;
+    }
+}
+
+size_t FFT::next_power_of_two(size_t value) {
+    size_t power = 1;
+    while (power < value) power <<= 1;
+    return power;
+}
+
+void FFT::transform(std::complex<double>* data, bool invert) const {
+    for (size_t i = 0; i < n; ++i) {
+        if (i < bit_reversed[i]) std::swap(data[i], data[bit_reversed[i]]);
+    }
+    // Iterative Cooley-Tukey; stage `len` uses every (n/len)-th twiddle
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        const size_t stride = n / len;
+        for (size_t start = 0; start < n; start += len) {
+            for (size_t k = 0; k < half; ++k) {
+                const std::complex<double> w = twiddles[k * stride];
+                const double w_imag = invert ? -w.imag() : w.imag();
+                // Written out: std::complex operator* adds NaN/Inf recovery we don't need
+                std::complex<double>& top = data[start + k];
+                std::complex<double>& bottom = data[start + k + half];
+                const double odd_real = bottom.real() * w.real() - bottom.imag() * w_imag;
+                const double odd_imag = bottom.real() * w_imag + bottom.imag() * w.real();
+                bottom = std::complex<double>(top.real() - odd_real, top.imag() - odd_imag);
+                top = std::complex<double>(top.real() + odd_real, top.imag() + odd_imag);
+            }
+        }
+    }
+}
@@ -0,0 +1,171 @@
+#include "InternedString.h"
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Chunk k holds FIRST_CHUNK << k strings, so 27 chunks cover every 32-bit id
+// and a chunk, once allocated, never moves
+const uint32_t FIRST_CHUNK_BITS = 6;
+const size_t FIRST_CHUNK = static_cast<size_t>(1) << FIRST_CHUNK_BITS;
+const size_t MAX_CHUNKS = 33 - FIRST_CHUNK_BITS;
+const uint32_t NO_ID = UINT32_MAX;  // Empty index slot
+const uint32_t MAX_STRINGS = NO_ID;
+
+size_t highest_bit(uint64_t value) {
+    size_t bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+}
+
+class Pool {
+private:
+    // Open-addressed index: (hash, id) per slot, linear probing, at most half
+    // full; the stored hash spares most string compares and all rehash hashing
+    struct IndexSlot {
+        uint32_t hash;
+        uint32_t id;
+    };
+
+    std::string* chunks[MAX_CHUNKS];
+    uint32_t count;
+    size_t heap_bytes;
+    std::vector<IndexSlot> index;
+    std::mutex mutex;
+
+    // Slot of id: the chunk is the position of the top bit of id + FIRST_CHUNK
+    std::string& slot(uint32_t id) const {
+        const uint64_t biased = static_cast<uint64_t>(id) + FIRST_CHUNK;
+        const size_t top = highest_bit(biased);
+        return chunks[top - FIRST_CHUNK_BITS][biased - (static_cast<uint64_t>(1) << top)];
+    }
+
+    static uint32_t hash_of(const std::string& value) {
+        const uint64_t hash = std::hash<std::string>()(value);
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+
+    // Index position holding value, or the empty position where it belongs
+    size_t probe(const std::string& value, uint32_t hash) const {
+        const size_t mask = index.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const IndexSlot& entry = index[i];
+            if (entry.id == NO_ID || (entry.hash == hash && slot(entry.id) == value)) {
+                return i;
+            }
+        }
+    }
+
+    void grow_index() {
+        std::vector<IndexSlot> old(index.size() * 2, IndexSlot{0, NO_ID});
+        old.swap(index);
+        const size_t mask = index.size() - 1;
+        for (const IndexSlot& entry : old) {
+            if (entry.id == NO_ID) continue;
+            size_t i = entry.hash & mask;
+            while (index[i].id != NO_ID) i = (i + 1) & mask;
+            index[i] = entry;
+        }
+    }
+
+    uint32_t insert(const std::string& value, uint32_t hash) {
+        if (count == MAX_STRINGS) {
+            throw std::length_error("intern pool is full");
+        }
+        if (2 * (static_cast<size_t>(count) + 1) > index.size()) {
+            grow_index();
+        }
+        const uint64_t biased = static_cast<uint64_t>(count) + FIRST_CHUNK;
+        const size_t chunk = highest_bit(biased) - FIRST_CHUNK_BITS;
+        if (!chunks[chunk]) {
+            chunks[chunk] = new std::string[FIRST_CHUNK << chunk];
+        }
+        const uint32_t id = count;
+        std::string& stored = slot(id);
+        stored = value;
+        index[probe(value, hash)] = IndexSlot{hash, id};
+        ++count;
+        if (stored.capacity() > std::string().capacity()) {
+            heap_bytes += stored.capacity() + 1;
+        }
+        return id;
+    }
+
+public:
+    Pool() : chunks(), count(0), heap_bytes(0), index(FIRST_CHUNK * 2, IndexSlot{0, NO_ID}), mutex() {
+        const std::string empty;
+        insert(empty, hash_of(empty));
+    }
+
+    ~Pool() {
+        for (std::string* chunk : chunks) {
+            delete[] chunk;
+        }
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    const std::string& get(uint32_t id) const { return slot(id); }
+
+    uint32_t intern(const std::string& value, bool add, bool& found) {
+        const uint32_t hash = hash_of(value);
+        std::lock_guard<std::mutex> lock(mutex);
+        const IndexSlot& entry = index[probe(value, hash)];
+        found = entry.id != NO_ID;
+        if (found) {
+            return entry.id;
+        }
+        return add ? insert(value, hash) : 0;
+    }
+
+    InternedString::PoolStats stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t slots = 0;
+        for (size_t chunk = 0; chunk < MAX_CHUNKS && chunks[chunk]; ++chunk) {
+            slots += FIRST_CHUNK << chunk;
+        }
+        InternedString::PoolStats result = {
+            count, slots * sizeof(std::string) + heap_bytes + index.size() * sizeof(IndexSlot)};
+        return result;
+    }
+};
+
+// Never destroyed, so tracks torn down during static destruction can still print their titles
+Pool& pool() {
+    static Pool* instance = new Pool();
+    return *instance;
+}
+
+} // namespace
+
+InternedString::InternedString(const std::string& value) : id(0) {
+    if (!value.empty()) {
+        bool found = false;
+        id = pool().intern(value, true, found);
+    }
+}
+
+const std::string& InternedString::str() const {
+    return pool().get(id);
+}
+
+bool InternedString::find(const std::string& value, InternedString& out) {
+    bool found = false;
+    const uint32_t existing = pool().intern(value, false, found);
+    if (found) {
+        out.id = existing;
+    }
+    return found;
+}
+
+InternedString::PoolStats InternedString::pool_stats() {
+    return pool().stats();
+}
+
+std::ostream& operator<<(std::ostream& out, const InternedString& value) {
+    return out << value.str();
+}
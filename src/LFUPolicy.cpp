@@ -0,0 +1,56 @@
+#include "LFUPolicy.h"
+
+void LFUPolicy::attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) {
+    EvictionPolicy::attach(slot_storage, cache_capacity);
+    buckets.clear();
+    min_frequency = 0;
+}
+
+void LFUPolicy::detach(size_t idx) {
+    uint64_t frequency = (*slots)[idx].frequency;
+    auto it = buckets.find(frequency);
+    it->second.remove(*slots, idx);
+    if (it->second.empty()) {
+        buckets.erase(it);
+        if (frequency == min_frequency) {
+            min_frequency = 0;
+        }
+    }
+}
+
+void LFUPolicy::onInsert(size_t idx) {
+    (*slots)[idx].frequency = 1;
+    buckets[1].pushFront(*slots, idx);
+    min_frequency = 1;
+}
+
+void LFUPolicy::onHit(size_t idx) {
+    detach(idx);
+    uint64_t frequency = ++(*slots)[idx].frequency;
+    buckets[frequency].pushFront(*slots, idx);
+    if (min_frequency == 0 || frequency < min_frequency) {
+        min_frequency = frequency;
+    }
+}
+
+void LFUPolicy::onRemove(size_t idx) {
+    detach(idx);
+    (*slots)[idx].frequency = 0;
+}
+
+void LFUPolicy::onMove(size_t from, size_t to) {
+    buckets[(*slots)[to].frequency].relink(*slots, from, to);
+}
+
+size_t LFUPolicy::selectVictim() {
+    if (buckets.empty()) return CacheSlot::NIL;
+    if (min_frequency == 0) {
+        // Only after a removal emptied the lowest bucket; inserts and hits keep it exact
+        for (const auto& bucket : buckets) {
+            if (min_frequency == 0 || bucket.first < min_frequency) {
+                min_frequency = bucket.first;
+            }
+        }
+    }
+    return buckets[min_frequency].tail();
+}
@@ -1,50 +1,156 @@
 #include "LRUCache.h"
+#include "LRUPolicy.h"
+#include <algorithm>
 #include <iostream>
+#include <utility>
 
 LRUCache::LRUCache(size_t capacity)
-    : slots(capacity), max_size(capacity), access_counter(0) {}
+    : slots(capacity), max_size(capacity), access_counter(0), index(),
+      free_head(CacheSlot::NIL), used(0), max_bytes(0), used_bytes(0), peak_bytes(0),
+      policy(new LRUPolicy()) {
+    index.reserve(capacity);
+    resetFreeList(0);
+    policy->attach(&slots, max_size);
+}
 
 bool LRUCache::contains(const std::string& track_id) const {
     return findSlot(track_id) != max_size;
 }
 
+bool LRUCache::contains(InternedString track_id) const {
+    return findSlot(track_id) != max_size;
+}
+
 AudioTrack* LRUCache::get(const std::string& track_id) {
+    InternedString key;
+    // A title never interned was never cached
+    if (!InternedString::find(track_id, key)) return nullptr;
+    return get(key);
+}
+
+AudioTrack* LRUCache::get(InternedString track_id) {
     size_t idx = findSlot(track_id);
     if (idx == max_size) return nullptr;
+    policy->onHit(idx);
     return slots[idx].access(++access_counter);
 }
 
-/**
- * TODO: Implement the put() method for LRUCache
- */
+AudioTrack* LRUCache::peek(const std::string& track_id) const {
+    InternedString key;
+    if (!InternedString::find(track_id, key)) return nullptr;
+    return peek(key);
+}
+
+AudioTrack* LRUCache::peek(InternedString track_id) const {
+    size_t idx = findSlot(track_id);
+    return idx == max_size ? nullptr : slots[idx].getTrack();
+}
+
 bool LRUCache::put(PointerWrapper<AudioTrack> track) {
-    return false; // Placeholder
+    if (!track || (max_size == 0 && max_bytes == 0)) return false;
+
+    const std::string& key = track->get_title();
+    size_t idx = findSlot(track->get_title_id());
+    if (idx != max_size) {
+        // Same key already cached: replace in place and treat as a fresh access
+        used_bytes -= slots[idx].getBytes();
+        slots[idx].store(std::move(track), ++access_counter);
+        used_bytes += slots[idx].getBytes();
+        peak_bytes = std::max(peak_bytes, used_bytes);
+        policy->onHit(idx);
+        return false;
+    }
+
+    policy->onMiss(key);
+    bool evicted = false;
+    if (max_bytes > 0) {
+        const size_t bytes = track->memory_footprint();
+        while (used > 0 && used_bytes + bytes > max_bytes && evictLRU()) {
+            evicted = true;
+        }
+        if (free_head == CacheSlot::NIL) {
+            grow(max_size == 0 ? 1 : max_size * 2);
+        }
+    } else if (free_head == CacheSlot::NIL) {
+        evicted = evictLRU();
+    }
+    storeInFreeSlot(std::move(track), ++access_counter);
+    return evicted;
 }
 
 bool LRUCache::evictLRU() {
-    size_t lru = findLRUSlot();
-    if (lru == max_size || !slots[lru].isOccupied()) return false;
-    slots[lru].clear();
+    size_t victim = findLRUSlot();
+    if (victim == max_size || !slots[victim].isOccupied()) return false;
+    evictSlot(victim);
+    return true;
+}
+
+void LRUCache::evictSlot(size_t victim) {
+    policy->onEvict(victim);
+    index.erase(slots[victim].getKeyId().get_id());
+    used_bytes -= slots[victim].getBytes();
+    slots[victim].clear();
+    pushFree(victim);
+    --used;
+}
+
+const std::string* LRUCache::victimFor(const AudioTrack& incoming) const {
+    const size_t victim = findVictimSlot(incoming);
+    return victim == max_size ? nullptr : &slots[victim].getKey();
+}
+
+bool LRUCache::victimFor(const AudioTrack& incoming, InternedString& victim) const {
+    const size_t idx = findVictimSlot(incoming);
+    if (idx == max_size) return false;
+    victim = slots[idx].getKeyId();
     return true;
 }
 
+size_t LRUCache::findVictimSlot(const AudioTrack& incoming) const {
+    if (contains(incoming.get_title_id())) return max_size;
+    if (max_bytes > 0) {
+        if (used == 0 || used_bytes + incoming.memory_footprint() <= max_bytes) return max_size;
+    } else if (max_size == 0 || free_head != CacheSlot::NIL) {
+        return max_size;
+    }
+    size_t victim = findLRUSlot();
+    if (victim == max_size || !slots[victim].isOccupied()) return max_size;
+    return victim;
+}
+
 size_t LRUCache::size() const {
-    size_t count = 0;
-    for (const auto& slot : slots) if (slot.isOccupied()) ++count;
-    return count;
+    return used;
 }
 
 void LRUCache::clear() {
     for (auto& slot : slots) {
         slot.clear();
     }
+    index.clear();
+    used = 0;
+    used_bytes = 0;
+    resetFreeList(0);
+    policy->attach(&slots, max_size);
 }
 
 void LRUCache::displayStatus() const {
+    if (max_bytes > 0) {
+        // Slot storage grows on demand here, so only occupied slots are listed
+        std::cout << "[LRUCache] Status: " << size() << " tracks, "
+                  << used_bytes << "/" << max_bytes << " bytes used\n";
+        for (size_t i = 0; i < max_size; ++i) {
+            if (slots[i].isOccupied()) {
+                std::cout << "  Slot " << i << ": " << slots[i].getKey()
+                          << " (" << slots[i].getBytes() << " bytes, last access: "
+                          << slots[i].getLastAccessTime() << ")\n";
+            }
+        }
+        return;
+    }
     std::cout << "[LRUCache] Status: " << size() << "/" << max_size << " slots used\n";
     for (size_t i = 0; i < max_size; ++i) {
         if(slots[i].isOccupied()){
-            std::cout << "  Slot " << i << ": " << slots[i].getTrack()->get_title()
+            std::cout << "  Slot " << i << ": " << slots[i].getKey()
                       << " (last access: " << slots[i].getLastAccessTime() << ")\n";
         } else {
             std::cout << "  Slot " << i << ": [EMPTY]\n";
@@ -53,32 +159,171 @@ void LRUCache::displayStatus() const {
 }
 
 size_t LRUCache::findSlot(const std::string& track_id) const {
-    for (size_t i = 0; i < max_size; ++i) {
-        if (slots[i].isOccupied() && slots[i].getTrack()->get_title() == track_id) return i;
-    }
-    return max_size;
+    InternedString key;
+    return InternedString::find(track_id, key) ? findSlot(key) : max_size;
+}
 
+size_t LRUCache::findSlot(InternedString track_id) const {
+    auto it = index.find(track_id.get_id());
+    return it == index.end() ? max_size : it->second;
 }
 
-/**
- * TODO: Implement the findLRUSlot() method for LRUCache
- */
 size_t LRUCache::findLRUSlot() const {
-    return 0; // Placeholder
+    size_t victim = policy->selectVictim();
+    return victim == CacheSlot::NIL ? max_size : victim;
 }
 
 size_t LRUCache::findEmptySlot() const {
-    for (size_t i = 0; i < max_size; ++i) {
-        if (!slots[i].isOccupied()) return i;
+    return free_head == CacheSlot::NIL ? max_size : free_head;
+}
+
+size_t LRUCache::storeInFreeSlot(PointerWrapper<AudioTrack> track, uint64_t access_time) {
+    size_t idx = findEmptySlot();
+    free_head = slots[idx].next;
+    slots[idx].next = CacheSlot::NIL;
+    slots[idx].store(std::move(track), access_time);
+    index[slots[idx].getKeyId().get_id()] = idx;
+    ++used;
+    used_bytes += slots[idx].getBytes();
+    peak_bytes = std::max(peak_bytes, used_bytes);
+    policy->onInsert(idx);
+    return idx;
+}
+
+void LRUCache::grow(size_t capacity) {
+    const size_t old_size = slots.size();
+    if (capacity > slots.capacity()) {
+        // Geometric reallocation, so a series of small grows stays amortized O(1) per slot
+        slots.reserve(std::max(capacity, 2 * slots.capacity()));
     }
-    return max_size;
+    slots.resize(capacity);
+    max_size = capacity;
+    // reserve() may rehash even when the buckets already suffice; only call it when they do not
+    if (static_cast<double>(capacity) > index.max_load_factor() * static_cast<double>(index.bucket_count())) {
+        index.reserve(std::max(capacity, 2 * index.size()));
+    }
+    resetFreeList(old_size);
+    policy->onCapacityChange(max_size);
 }
 
-void LRUCache::set_capacity(size_t capacity){
-    if (max_size == capacity)
-        return;
-    //udpate max size
+void LRUCache::shrink(size_t capacity, std::vector<std::string>& evicted) {
+    while (used > capacity) {
+        size_t victim = findLRUSlot();
+        if (victim == max_size || !slots[victim].isOccupied()) {
+            // No victim from the policy: take the highest occupied slot, so the
+            // survivors always fit below the new end before compacting
+            victim = slots.size();
+            while (!slots[victim - 1].isOccupied()) --victim;  // used > 0, so one is occupied
+            --victim;
+        }
+        evicted.push_back(slots[victim].getKey());
+        evictSlot(victim);
+    }
+
+    // Survivors above the new end move down into free slots; at most `used` of them
+    size_t hole = 0;
+    for (size_t from = capacity; from < slots.size(); ++from) {
+        if (!slots[from].isOccupied()) continue;
+        while (slots[hole].isOccupied()) ++hole;
+        moveSlot(from, hole);
+    }
+
+    slots.resize(capacity);
     max_size = capacity;
-    //update the slots vector
+    free_head = CacheSlot::NIL;
+    for (size_t i = capacity; i > 0; --i) {
+        if (!slots[i - 1].isOccupied()) pushFree(i - 1);
+    }
+    policy->onCapacityChange(max_size);
+}
+
+void LRUCache::moveSlot(size_t from, size_t to) {
+    CacheSlot& source = slots[from];
+    CacheSlot& target = slots[to];
+    const uint64_t access_time = source.getLastAccessTime();
+    target.prev = source.prev;
+    target.next = source.next;
+    target.frequency = source.frequency;
+    target.tag = source.tag;
+    used_bytes -= source.getBytes();
+    target.store(source.take(), access_time);
+    used_bytes += target.getBytes();
+    source.prev = source.next = CacheSlot::NIL;
+    source.frequency = 0;
+    source.tag = 0;
+    index[target.getKeyId().get_id()] = to;
+    policy->onMove(from, to);
+}
+
+void LRUCache::pushFree(size_t idx) {
+    slots[idx].prev = CacheSlot::NIL;
+    slots[idx].next = free_head;
+    free_head = idx;
+}
+
+void LRUCache::resetFreeList(size_t from) {
+    // Push in reverse so the lowest index is handed out first
+    for (size_t i = slots.size(); i > from; --i) {
+        pushFree(i - 1);
+    }
+}
+
+void LRUCache::rebuild(size_t capacity) {
+    // Keep the most recent entries and compact them into the lower slots
+    std::vector<std::pair<uint64_t, PointerWrapper<AudioTrack> > > kept;
+    kept.reserve(used);
+    for (auto& slot : slots) {
+        if (slot.isOccupied()) {
+            uint64_t time = slot.getLastAccessTime();
+            kept.push_back(std::make_pair(time, slot.take()));
+        }
+    }
+    std::sort(kept.begin(), kept.end(),
+              [](const std::pair<uint64_t, PointerWrapper<AudioTrack> >& a,
+                 const std::pair<uint64_t, PointerWrapper<AudioTrack> >& b) {
+                  return a.first > b.first;
+              });
+    if (kept.size() > capacity) {
+        kept.resize(capacity);
+    }
+
+    max_size = capacity;
+    slots.clear();
     slots.resize(capacity);
-}
\ No newline at end of file
+    index.clear();
+    index.reserve(capacity);
+    free_head = CacheSlot::NIL;
+    used = 0;
+    used_bytes = 0;
+    resetFreeList(0);
+    policy->attach(&slots, max_size);
+
+    // Oldest first, so the policy sees the same relative order as before
+    for (size_t i = kept.size(); i > 0; --i) {
+        storeInFreeSlot(std::move(kept[i - 1].second), kept[i - 1].first);
+    }
+}
+
+std::vector<std::string> LRUCache::set_capacity(size_t capacity) {
+    std::vector<std::string> evicted;
+    if (capacity > max_size) {
+        grow(capacity);
+    } else if (capacity < max_size) {
+        shrink(capacity, evicted);
+    }
+    return evicted;
+}
+
+void LRUCache::set_byte_budget(size_t bytes) {
+    max_bytes = bytes;
+    if (max_bytes == 0) return;
+    while (used > 0 && used_bytes > max_bytes) {
+        if (!evictLRU()) break;
+    }
+}
+
+void LRUCache::set_policy(PointerWrapper<EvictionPolicy> new_policy) {
+    if (!new_policy) return;
+    policy = std::move(new_policy);
+    rebuild(max_size);
+}
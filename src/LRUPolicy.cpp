@@ -0,0 +1,28 @@
+#include "LRUPolicy.h"
+
+void LRUPolicy::attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) {
+    EvictionPolicy::attach(slot_storage, cache_capacity);
+    recency.clear();
+}
+
+void LRUPolicy::onInsert(size_t idx) {
+    recency.pushFront(*slots, idx);
+}
+
+void LRUPolicy::onHit(size_t idx) {
+    if (recency.head() == idx) return;
+    recency.remove(*slots, idx);
+    recency.pushFront(*slots, idx);
+}
+
+void LRUPolicy::onRemove(size_t idx) {
+    recency.remove(*slots, idx);
+}
+
+void LRUPolicy::onMove(size_t from, size_t to) {
+    recency.relink(*slots, from, to);
+}
+
+size_t LRUPolicy::selectVictim() {
+    return recency.tail();
+}
@@ -7,34 +7,47 @@ MP3Track::MP3Track(const std::string& title, const std::vector<std::string>& art
                    int duration, int bpm, int bitrate, bool has_tags)
     : AudioTrack(title, artists, duration, bpm), bitrate(bitrate), has_id3_tags(has_tags) {
 
-    std::cout << "MP3Track created: " << bitrate << " kbps" << std::endl;
+    construction_log() << "MP3Track created: " << bitrate << " kbps" << std::endl;
 }
 
-// ========== TODO: STUDENTS IMPLEMENT THESE VIRTUAL FUNCTIONS ==========
+// ========== VIRTUAL FUNCTION IMPLEMENTATIONS ==========
 
 void MP3Track::load() {
     std::cout << "[MP3Track::load] Loading MP3: \"" << title
               << "\" at " << bitrate << " kbps...\n";
-    // TODO: Implement MP3 loading with format-specific operations
-    // NOTE: Use exactly 2 spaces before the arrow (→) character
-    
+    if (has_id3_tags) {
+        std::cout << "  → Processing ID3 metadata (artist info, album art, etc.)...\n";
+    } else {
+        std::cout << "  → No ID3 tags found.\n";
+    }
+    std::cout << "  → Decoding MP3 frames...\n";
+    std::cout << "  → Load complete.\n";
 }
 
 void MP3Track::analyze_beatgrid() {
-     std::cout << "[MP3Track::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"\n";
-    // TODO: Implement MP3-specific beat detection analysis
-    // NOTE: Use exactly 2 spaces before each arrow (→) character
-
+    std::cout << "[MP3Track::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"\n";
+    int beats = estimate_beats();
+    double precision_factor = bitrate / 320.0;
+    std::cout << "  → Estimated beats: " << beats
+              << "  → Compression precision factor: " << precision_factor << "\n";
 }
 
 double MP3Track::get_quality_score() const {
-    // TODO: Implement comprehensive quality scoring
-    // NOTE: This method does NOT print anything
+    double score = (bitrate / 320.0) * 100.0;
+    if (has_id3_tags) {
+        score += 5.0;
+    }
+    if (bitrate < 128) {
+        score -= 10.0;
+    }
+    return std::max(0.0, std::min(100.0, score));
+}
 
-    return 0.0; // Replace with your implementation
+size_t MP3Track::audio_bytes() const {
+    // kbps -> bytes per second is x 1000 / 8
+    return static_cast<size_t>(std::max(0, duration_seconds)) * static_cast<size_t>(std::max(0, bitrate)) * 125;
 }
 
 PointerWrapper<AudioTrack> MP3Track::clone() const {
-    // TODO: Implement polymorphic cloning
-    return PointerWrapper<AudioTrack>(nullptr); // Replace with your implementation
-}
\ No newline at end of file
+    return PointerWrapper<AudioTrack>(new MP3Track(*this));
+}
@@ -0,0 +1,75 @@
+#include "MissRatioCurve.h"
+#include <unordered_map>
+
+namespace {
+
+// Fenwick (binary indexed) tree over 1-based positions holding 0/1 markers
+class FenwickTree {
+private:
+    std::vector<int> tree;
+
+public:
+    explicit FenwickTree(size_t size) : tree(size + 1, 0) {}
+
+    void add(size_t position, int delta) {
+        for (; position < tree.size(); position += position & (~position + 1)) {
+            tree[position] += delta;
+        }
+    }
+
+    // Sum of markers at positions [1, position]
+    size_t prefix(size_t position) const {
+        long long sum = 0;
+        for (; position > 0; position -= position & (~position + 1)) {
+            sum += tree[position];
+        }
+        return static_cast<size_t>(sum);
+    }
+};
+
+} // namespace
+
+MissRatioCurve::MissRatioCurve(const std::vector<std::string>& trace)
+    : cumulative_hits(), total_accesses(trace.size()), distinct_keys(0) {
+    FenwickTree latest(trace.size());
+    std::unordered_map<std::string, size_t> last_position;  // key -> 1-based position
+    last_position.reserve(trace.size());
+    std::vector<size_t> histogram;                           // [d] = reuses at distance d
+
+    for (size_t t = 1; t <= trace.size(); ++t) {
+        auto found = last_position.find(trace[t - 1]);
+        if (found == last_position.end()) {
+            last_position.emplace(trace[t - 1], t);
+        } else {
+            // Distinct keys touched strictly between the two accesses
+            size_t previous = found->second;
+            size_t distance = latest.prefix(t - 1) - latest.prefix(previous);
+            if (distance >= histogram.size()) {
+                histogram.resize(distance + 1, 0);
+            }
+            histogram[distance]++;
+            latest.add(previous, -1);
+            found->second = t;
+        }
+        latest.add(t, 1);
+    }
+
+    distinct_keys = last_position.size();
+    cumulative_hits.assign(distinct_keys + 1, 0);
+    for (size_t capacity = 1; capacity <= distinct_keys; ++capacity) {
+        size_t at_distance = capacity - 1 < histogram.size() ? histogram[capacity - 1] : 0;
+        cumulative_hits[capacity] = cumulative_hits[capacity - 1] + at_distance;
+    }
+}
+
+size_t MissRatioCurve::hits(size_t capacity) const {
+    if (capacity >= cumulative_hits.size()) {
+        return cumulative_hits.back();
+    }
+    return cumulative_hits[capacity];
+}
+
+double MissRatioCurve::hit_rate(size_t capacity) const {
+    if (total_accesses == 0) return 0.0;
+    return static_cast<double>(hits(capacity)) / total_accesses;
+}
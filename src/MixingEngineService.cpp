@@ -1,33 +1,67 @@
 #include "MixingEngineService.h"
 #include <iostream>
 #include <memory>
+#include <cstdlib>
 
 
-/**
- * TODO: Implement MixingEngineService constructor
- */
 MixingEngineService::MixingEngineService()
-    : active_deck(0)
+    : decks(), active_deck(0), auto_sync(false), bpm_tolerance(0)
 {
-    // Your implementation here
+    decks[0] = nullptr;
+    decks[1] = nullptr;
+    std::cout << "[MixingEngineService] Initialized with 2 empty decks.\n";
 }
 
-/**
- * TODO: Implement MixingEngineService destructor
- */
 MixingEngineService::~MixingEngineService() {
-    // Your implementation here
+    std::cout << "[MixingEngineService] Cleaning up decks...\n";
+    for (size_t i = 0; i < 2; ++i) {
+        delete decks[i];
+        decks[i] = nullptr;
+    }
 }
 
 
 /**
- * TODO: Implement loadTrackToDeck method
  * @param track: Reference to the track to be loaded
  * @return: Index of the deck where track was loaded, or -1 on failure
  */
 int MixingEngineService::loadTrackToDeck(const AudioTrack& track) {
-    // Your implementation here
-    return -1; // Placeholder
+    std::cout << "\n=== Loading Track to Deck ===\n";
+    PointerWrapper<AudioTrack> cloned = track.clone();
+    if (!cloned) {
+        std::cerr << "[ERROR] Track: \"" << track.get_title() << "\" failed to clone\n";
+        return -1;
+    }
+
+    size_t target_deck = 1 - active_deck;
+    std::cout << "[Deck Switch] Target deck: " << target_deck << "\n";
+    if (decks[target_deck]) {
+        delete decks[target_deck];
+        decks[target_deck] = nullptr;
+    }
+
+    cloned->load();
+    cloned->analyze_beatgrid();
+
+    // Auto-sync beat-matches compatible tracks; incompatible BPMs are left untouched
+    if (auto_sync && can_mix_tracks(cloned)) {
+        sync_bpm(cloned);
+    }
+
+    decks[target_deck] = cloned.release();
+    std::cout << "[Load Complete] '" << decks[target_deck]->get_title()
+              << "' is now loaded on deck " << target_deck << "\n";
+
+    if (decks[active_deck]) {
+        std::cout << "[Unload] Unloading previous deck " << active_deck
+                  << " (" << decks[active_deck]->get_title() << ")\n";
+        delete decks[active_deck];
+        decks[active_deck] = nullptr;
+    }
+
+    active_deck = target_deck;
+    std::cout << "[Active Deck] Switched to deck " << target_deck << "\n";
+    return static_cast<int>(target_deck);
 }
 
 /**
@@ -46,22 +80,28 @@ void MixingEngineService::displayDeckStatus() const {
 }
 
 /**
- * TODO: Implement can_mix_tracks method
- * 
  * Check if two tracks can be mixed based on BPM difference.
  * 
  * @param track: Track to check for mixing compatibility
  * @return: true if BPM difference <= tolerance, false otherwise
  */
 bool MixingEngineService::can_mix_tracks(const PointerWrapper<AudioTrack>& track) const {
-    // Your implementation here
-    return false; // Placeholder
+    if (!decks[active_deck] || !track) {
+        return false;
+    }
+    int bpm_difference = std::abs(decks[active_deck]->get_bpm() - track->get_bpm());
+    return bpm_difference <= bpm_tolerance;
 }
 
 /**
- * TODO: Implement sync_bpm method
  * @param track: Track to synchronize with active deck
  */
 void MixingEngineService::sync_bpm(const PointerWrapper<AudioTrack>& track) const {
-    // Your implementation here
+    if (!decks[active_deck] || !track) {
+        return;
+    }
+    int original_bpm = track->get_bpm();
+    int average_bpm = (original_bpm + decks[active_deck]->get_bpm()) / 2;
+    track->set_bpm(average_bpm);
+    std::cout << "[Sync BPM] Syncing BPM from " << original_bpm << " to " << average_bpm << "\n";
 }
@@ -2,98 +2,306 @@
 #include "AudioTrack.h"
 #include <iostream>
 #include <algorithm>
-Playlist::Playlist(const std::string& name) 
-    : head(nullptr), playlist_name(name), track_count(0) {
+namespace {
+
+const size_t FIRST_CHUNK_NODES = 8;
+const size_t MAX_CHUNK_NODES = 4096;
+
+} // namespace
+
+PlaylistStats::PlaylistStats()
+    : total_duration(0), bpm_sum(0), tracks(0), bpm_counts(), format_counts(), tier_counts() {}
+
+void PlaylistStats::add(PlaylistNode& node) {
+    const AudioTrack& track = *node.track;
+    node.counted_bpm = track.get_bpm();
+    node.counted_tier = track.get_quality_tier();
+    total_duration += track.get_duration();
+    bpm_sum += node.counted_bpm;
+    tracks++;
+    bpm_counts[node.counted_bpm]++;
+    format_counts[static_cast<size_t>(track.get_format())]++;
+    tier_counts[static_cast<size_t>(node.counted_tier)]++;
+}
+
+void PlaylistStats::remove(const PlaylistNode& node) {
+    const AudioTrack& track = *node.track;
+    total_duration -= track.get_duration();
+    bpm_sum -= node.counted_bpm;
+    tracks--;
+    auto bucket = bpm_counts.find(node.counted_bpm);
+    if (bucket != bpm_counts.end() && --bucket->second == 0) {
+        bpm_counts.erase(bucket);
+    }
+    format_counts[static_cast<size_t>(track.get_format())]--;
+    tier_counts[static_cast<size_t>(node.counted_tier)]--;
+}
+
+void PlaylistStats::clear() {
+    *this = PlaylistStats();
+}
+
+Playlist::Playlist(const std::string& name, bool owns_tracks) 
+    : head(nullptr), tail(nullptr), playlist_name(name), track_count(0), owns_tracks(owns_tracks),
+      title_index(), stats(),
+      chunks(), chunk_capacity(0), chunk_used(0), free_nodes(nullptr) {
     std::cout << "Created playlist: " << name << std::endl;
 }
-// TODO: Fix memory leaks!
-// Students must fix this in Phase 1
 Playlist::~Playlist() {
     #ifdef DEBUG
     std::cout << "Destroying playlist: " << playlist_name << std::endl;
     #endif
-    //~~~~Playlist has to delete all of the nodes~~~~~
-    PlaylistNode* curr = head;
-    while(curr){
-        PlaylistNode* next = curr->next;
-        delete curr;
-        curr = next;
+    clear_nodes();
+}
+
+Playlist::Playlist(const Playlist& other)
+    : head(nullptr), tail(nullptr), playlist_name(other.playlist_name), track_count(0),
+      owns_tracks(other.owns_tracks), title_index(), stats(),
+      chunks(), chunk_capacity(0), chunk_used(0), free_nodes(nullptr) {
+    title_index.reserve(other.title_index.size());
+    for (PlaylistNode* current = other.head; current; current = current->next) {
+        AudioTrack* track = current->track;
+        if (owns_tracks) {
+            track = current->track->clone().release();
+            if (!track) {
+                continue;
+            }
+        }
+        PlaylistNode* node = acquire_node(track);
+        node->prev = tail;
+        if (tail) {
+            tail->next = node;
+        } else {
+            head = node;
+        }
+        tail = node;
+        index_node(node, false);
+        stats.add(*node);
+        track_count++;
+    }
+}
+
+Playlist& Playlist::operator=(const Playlist& other) {
+    if (this != &other) {
+        Playlist copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+Playlist::Playlist(Playlist&& other) noexcept
+    : head(other.head), tail(other.tail), playlist_name(std::move(other.playlist_name)),
+      track_count(other.track_count), owns_tracks(other.owns_tracks), title_index(std::move(other.title_index)),
+      stats(std::move(other.stats)), chunks(std::move(other.chunks)), chunk_capacity(other.chunk_capacity),
+      chunk_used(other.chunk_used), free_nodes(other.free_nodes) {
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.title_index.clear();
+    other.stats.clear();
+    other.track_count = 0;
+    other.chunks.clear();
+    other.chunk_capacity = 0;
+    other.chunk_used = 0;
+    other.free_nodes = nullptr;
+}
+
+Playlist& Playlist::operator=(Playlist&& other) noexcept {
+    if (this != &other) {
+        clear_nodes();
+        head = other.head;
+        tail = other.tail;
+        playlist_name = std::move(other.playlist_name);
+        track_count = other.track_count;
+        owns_tracks = other.owns_tracks;
+        title_index = std::move(other.title_index);
+        stats = std::move(other.stats);
+        chunks = std::move(other.chunks);
+        chunk_capacity = other.chunk_capacity;
+        chunk_used = other.chunk_used;
+        free_nodes = other.free_nodes;
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.title_index.clear();
+        other.stats.clear();
+        other.track_count = 0;
+        other.chunks.clear();
+        other.chunk_capacity = 0;
+        other.chunk_used = 0;
+        other.free_nodes = nullptr;
     }
+    return *this;
+}
+
+void Playlist::clear_nodes() {
+    if (owns_tracks) {
+        for (PlaylistNode* node = head; node; node = node->next) {
+            delete node->track;
+        }
+    }
+    chunks.clear();
+    chunk_capacity = 0;
+    chunk_used = 0;
+    free_nodes = nullptr;
     head = nullptr;
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    tail = nullptr;
+    track_count = 0;
+    title_index.clear();
+    stats.clear();
+}
+
+PlaylistNode* Playlist::acquire_node(AudioTrack* track) {
+    PlaylistNode* node = free_nodes;
+    if (node) {
+        free_nodes = node->next;
+    } else {
+        if (chunk_used == chunk_capacity) {
+            chunk_capacity = chunks.empty() ? FIRST_CHUNK_NODES : std::min(chunk_capacity * 2, MAX_CHUNK_NODES);
+            chunks.emplace_back(new PlaylistNode[chunk_capacity]);
+            chunk_used = 0;
+        }
+        node = &chunks.back()[chunk_used++];
+    }
+    node->track = track;
+    node->prev = nullptr;
+    node->next = nullptr;
+    return node;
+}
+
+void Playlist::release_node(PlaylistNode* node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        tail = node->prev;
+    }
+    stats.remove(*node);
+    if (owns_tracks) {
+        delete node->track;
+    }
+    node->track = nullptr;
+    node->prev = nullptr;
+    node->next = free_nodes;
+    free_nodes = node;
+    track_count--;
+}
+
+void Playlist::index_node(PlaylistNode* node, bool first) {
+    auto inserted = title_index.emplace(node->track->get_title(), TitleEntry{node, 1});
+    if (!inserted.second) {
+        inserted.first->second.count++;
+        if (first) {
+            inserted.first->second.first = node;
+        }
+    }
 }
 
-void Playlist::add_track(AudioTrack* track) {
+void Playlist::unindex_node(PlaylistNode* node) {
+    auto entry = title_index.find(node->track->get_title());
+    if (entry == title_index.end()) {
+        return;
+    }
+    if (--entry->second.count == 0) {
+        title_index.erase(entry);
+    } else if (entry->second.first == node) {
+        // The next node with this title becomes the indexed one
+        const InternedString key = node->track->get_title_id();
+        PlaylistNode* next_match = node->next;
+        while (next_match->track->get_title_id() != key) {
+            next_match = next_match->next;
+        }
+        entry->second.first = next_match;
+    }
+}
+
+PlaylistNode* Playlist::add_track(AudioTrack* track) {
     if (!track) {
         std::cout << "[Error] Cannot add null track to playlist" << std::endl;
-        return;
+        return nullptr;
     }
 
-    // Create new node - this allocates memory!
-    PlaylistNode* new_node = new PlaylistNode(track);
+    PlaylistNode* new_node = acquire_node(track);
 
     // Add to front of list
     new_node->next = head;
+    if (head) {
+        head->prev = new_node;
+    } else {
+        tail = new_node;
+    }
     head = new_node;
+    index_node(new_node, true);
+    stats.add(*new_node);
     track_count++;
 
     std::cout << "Added '" << track->get_title() << "' to playlist '" 
               << playlist_name << "'" << std::endl;
+    return new_node;
 }
 
-void Playlist::remove_track(const std::string& title) {
-    PlaylistNode* current = head;
-    PlaylistNode* prev = nullptr;
-
-    // Find the track to remove
-    while (current && current->track->get_title() != title) {
-        prev = current;
-        current = current->next;
+PlaylistNode* Playlist::append_track(AudioTrack* track) {
+    if (!track) {
+        std::cout << "[Error] Cannot add null track to playlist" << std::endl;
+        return nullptr;
     }
 
-    if (current) {
-        // Remove from linked list
-        if (prev) {
-            prev->next = current->next;
-        } else {
-            head = current->next;
-        }
-
-        //~~~~the method has to delete the node as well~~~~
-        delete current; 
-        //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-        track_count--;
-        std::cout << "Removed '" << title << "' from playlist" << std::endl;
+    PlaylistNode* new_node = acquire_node(track);
 
+    // Add to end of list
+    new_node->prev = tail;
+    if (tail) {
+        tail->next = new_node;
     } else {
+        head = new_node;
+    }
+    tail = new_node;
+    index_node(new_node, false);
+    stats.add(*new_node);
+    track_count++;
+
+    std::cout << "Added '" << track->get_title() << "' to playlist '" 
+              << playlist_name << "'" << std::endl;
+    return new_node;
+}
+
+void Playlist::remove_track(const std::string& title) {
+    auto entry = title_index.find(title);
+    if (entry == title_index.end()) {
         std::cout << "Track '" << title << "' not found in playlist" << std::endl;
+        return;
     }
+    PlaylistNode* node = entry->second.first;
+    unindex_node(node);
+    release_node(node);
+    std::cout << "Removed '" << title << "' from playlist" << std::endl;
+}
+
+void Playlist::remove_track(PlaylistNode* node) {
+    if (!node || !node->track) {
+        std::cout << "[Error] Cannot remove a track that is not in the playlist" << std::endl;
+        return;
+    }
+    // Copy the title first: release_node may delete the track
+    const std::string title = node->track->get_title();
+    unindex_node(node);
+    release_node(node);
+    std::cout << "Removed '" << title << "' from playlist" << std::endl;
 }
 
 void Playlist::display() const {
     std::cout << "\n=== Playlist: " << playlist_name << " ===" << std::endl;
     std::cout << "Track count: " << track_count << std::endl;
 
-    PlaylistNode* current = head;
     int index = 1;
 
-    while (current) {
-        std::vector<std::string> artists = current->track->get_artists();
-        std::string artist_list;
-
-        std::for_each(artists.begin(), artists.end(), [&](const std::string& artist) {
-            if (!artist_list.empty()) {
-                artist_list += ", ";
-            }
-            artist_list += artist;
-        });
-
-        AudioTrack* track = current->track;
+    for (AudioTrack* track : *this) {
         std::cout << index << ". " << track->get_title() 
-                  << " by " << artist_list
+                  << " by " << track->get_artist_line()
                   << " (" << track->get_duration() << "s, " 
                   << track->get_bpm() << " BPM)" << std::endl;
-        current = current->next;
         index++;
     }
 
@@ -104,37 +312,15 @@ void Playlist::display() const {
 }
 
 AudioTrack* Playlist::find_track(const std::string& title) const {
-    PlaylistNode* current = head;
-
-    while (current) {
-        if (current->track->get_title() == title) {
-            return current->track;
-        }
-        current = current->next;
-    }
-
-    return nullptr;
-}
-
-int Playlist::get_total_duration() const {
-    int total = 0;
-    PlaylistNode* current = head;
-
-    while (current) {
-        total += current->track->get_duration();
-        current = current->next;
-    }
-
-    return total;
+    auto entry = title_index.find(title);
+    return entry == title_index.end() ? nullptr : entry->second.first->track;
 }
 
 std::vector<AudioTrack*> Playlist::getTracks() const {
     std::vector<AudioTrack*> tracks;
-    PlaylistNode* current = head;
-    while (current) {
-        if (current->track)
-            tracks.push_back(current->track);
-        current = current->next;
+    tracks.reserve(static_cast<size_t>(track_count));
+    for (AudioTrack* track : *this) {
+        tracks.push_back(track);
     }
     return tracks;
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
 
 // ========== PUBLIC METHODS (PROVIDED FOR STUDENTS) ==========
 
@@ -51,6 +53,48 @@ bool SessionFileParser::parse_config_file(const std::string& config_path, Sessio
                     std::cout << "[WARNING] Invalid cache size at line " << line_number << std::endl;
                 }
                 
+            } else if (key == "controller_cache_bytes") {
+                if (!parse_byte_size(value, config.controller_cache_bytes)) {
+                    std::cout << "[WARNING] Invalid cache byte budget at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "controller_cache_ceiling") {
+                if (!parse_byte_size(value, config.controller_cache_ceiling)) {
+                    std::cout << "[WARNING] Invalid cache memory ceiling at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "cache_policy") {
+                std::string policy = value.substr(0, value.find_first_of(" \t#"));
+                std::transform(policy.begin(), policy.end(), policy.begin(), ::tolower);
+                config.cache_policy = policy;
+                
+            } else if (key == "cache_admission") {
+                std::string filter = value.substr(0, value.find_first_of(" \t#"));
+                std::transform(filter.begin(), filter.end(), filter.begin(), ::tolower);
+                config.cache_admission = filter;
+                
+            } else if (key == "prefetch_lookahead") {
+                try {
+                    config.prefetch_lookahead = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid prefetch lookahead at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "waveform_format") {
+                std::string format = value.substr(0, value.find_first_of(" \t#"));
+                std::transform(format.begin(), format.end(), format.begin(), ::tolower);
+                config.waveform_format = format;
+                
+            } else if (key == "library_build_threads") {
+                try {
+                    config.library_build_threads = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid library build threads at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "library_build_log") {
+                config.library_build_log = parse_bool(value);
+                
             } else if (key == "bpm_tolerance") {
                 try {
                     config.bpm_tolerance = std::stoi(value);
@@ -156,6 +200,41 @@ bool SessionFileParser::parse_bool(const std::string& str) {
     return (lower_str == "true" || lower_str == "1" || lower_str == "yes");
 }
 
+bool SessionFileParser::parse_byte_size(const std::string& str, size_t& bytes) {
+    std::string value = trim_string(str.substr(0, str.find('#')));
+    if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0]))) {
+        return false;
+    }
+    
+    size_t digits_end = 0;
+    unsigned long long count = 0;
+    try {
+        count = std::stoull(value, &digits_end);
+    } catch (const std::exception& e) {
+        return false;
+    }
+    
+    std::string suffix = trim_string(value.substr(digits_end));
+    std::transform(suffix.begin(), suffix.end(), suffix.begin(), ::toupper);
+    unsigned long long multiplier = 1;
+    if (suffix == "K" || suffix == "KB") {
+        multiplier = 1ULL << 10;
+    } else if (suffix == "M" || suffix == "MB") {
+        multiplier = 1ULL << 20;
+    } else if (suffix == "G" || suffix == "GB") {
+        multiplier = 1ULL << 30;
+    } else if (!suffix.empty() && suffix != "B") {
+        return false;
+    }
+    
+    // Out of range (the product would wrap to a small budget)
+    if (count > SIZE_MAX / multiplier) {
+        return false;
+    }
+    bytes = static_cast<size_t>(count * multiplier);
+    return true;
+}
+
 bool SessionFileParser::is_comment_line(const std::string& line) {
     return !line.empty() && line[0] == '#';
 }
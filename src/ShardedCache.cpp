@@ -0,0 +1,253 @@
+#include "ShardedCache.h"
+#include <pthread.h>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+struct ShardedCache::Shard {
+    struct Entry {
+        std::string key;
+        std::shared_ptr<AudioTrack> track;
+        std::atomic<bool> referenced;  // CLOCK reference bit; set by readers without the write lock
+
+        Entry() : key(), track(), referenced(false) {}
+    };
+
+    // Holds the shard's read or write lock for its scope, counting contention
+    class Guard {
+    private:
+        pthread_rwlock_t& lock;
+
+    public:
+        Guard(const Shard& shard, bool write) : lock(shard.lock) {
+            shard.acquisitions.fetch_add(1, std::memory_order_relaxed);
+            const int busy = write ? pthread_rwlock_trywrlock(&lock) : pthread_rwlock_tryrdlock(&lock);
+            if (busy != 0) {
+                shard.contended.fetch_add(1, std::memory_order_relaxed);
+                if (write) {
+                    pthread_rwlock_wrlock(&lock);
+                } else {
+                    pthread_rwlock_rdlock(&lock);
+                }
+            }
+        }
+        ~Guard() { pthread_rwlock_unlock(&lock); }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    mutable pthread_rwlock_t lock;
+    std::unordered_map<std::string, size_t> index;  // key -> entry
+    std::unique_ptr<Entry[]> entries;
+    size_t capacity;
+    size_t used;   // Entries [0, used) are filled
+    size_t hand;   // CLOCK hand
+    mutable std::atomic<uint64_t> hits;
+    mutable std::atomic<uint64_t> misses;
+    std::atomic<uint64_t> inserts;
+    std::atomic<uint64_t> evictions;
+    mutable std::atomic<uint64_t> acquisitions;
+    mutable std::atomic<uint64_t> contended;
+    char padding[64];  // Keeps the next shard's lock and counters off this shard's cache lines
+
+    Shard()
+        : lock(), index(), entries(), capacity(0), used(0), hand(0), hits(0), misses(0), inserts(0),
+          evictions(0), acquisitions(0), contended(0), padding() {
+        pthread_rwlockattr_t attributes;
+        pthread_rwlockattr_init(&attributes);
+#if defined(__GLIBC__)
+        // glibc prefers readers by default, which can starve inserts under a read-heavy load
+        pthread_rwlockattr_setkind_np(&attributes, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+        pthread_rwlock_init(&lock, &attributes);
+        pthread_rwlockattr_destroy(&attributes);
+    }
+
+    ~Shard() { pthread_rwlock_destroy(&lock); }
+
+    Shard(const Shard&) = delete;
+    Shard& operator=(const Shard&) = delete;
+
+    void reset(size_t slots) {
+        capacity = slots;
+        entries.reset(slots ? new Entry[slots] : nullptr);
+        index.clear();
+        index.reserve(slots);
+        used = 0;
+        hand = 0;
+    }
+
+    Stats stats() const {
+        Stats result = {hits.load(std::memory_order_relaxed),
+                        misses.load(std::memory_order_relaxed),
+                        inserts.load(std::memory_order_relaxed),
+                        evictions.load(std::memory_order_relaxed),
+                        acquisitions.load(std::memory_order_relaxed),
+                        contended.load(std::memory_order_relaxed)};
+        return result;
+    }
+};
+
+ShardedCache::ShardedCache(size_t capacity, size_t shard_request)
+    : shards(), shard_total(1), shard_mask(0), total_capacity(capacity) {
+    size_t wanted = shard_request;
+    if (wanted == 0) {
+        const size_t hardware = std::thread::hardware_concurrency();
+        wanted = 4 * (hardware == 0 ? 1 : hardware);
+    }
+    while (shard_total < wanted) {
+        shard_total <<= 1;
+    }
+    // Every shard needs at least one slot
+    while (shard_total > 1 && shard_total > capacity) {
+        shard_total >>= 1;
+    }
+    shard_mask = shard_total - 1;
+
+    shards.reset(new Shard[shard_total]);
+    for (size_t i = 0; i < shard_total; ++i) {
+        shards[i].reset(capacity / shard_total + (i < capacity % shard_total ? 1 : 0));
+    }
+}
+
+ShardedCache::~ShardedCache() = default;
+
+ShardedCache::Shard& ShardedCache::shard_for(const std::string& track_id) const {
+    const size_t hash = std::hash<std::string>()(track_id);
+    // Fold the high bits in, so shard choice does not reuse the bits the shard's index buckets by
+    return shards[(hash ^ (hash >> 29)) & shard_mask];
+}
+
+std::shared_ptr<AudioTrack> ShardedCache::get(const std::string& track_id) {
+    Shard& shard = shard_for(track_id);
+    Shard::Guard guard(shard, false);
+    auto found = shard.index.find(track_id);
+    if (found == shard.index.end()) {
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return std::shared_ptr<AudioTrack>();
+    }
+    Shard::Entry& entry = shard.entries[found->second];
+    // Skip the store when the bit is already set, so hot entries do not bounce between cores
+    if (!entry.referenced.load(std::memory_order_relaxed)) {
+        entry.referenced.store(true, std::memory_order_relaxed);
+    }
+    shard.hits.fetch_add(1, std::memory_order_relaxed);
+    return entry.track;
+}
+
+std::shared_ptr<AudioTrack> ShardedCache::peek(const std::string& track_id) const {
+    const Shard& shard = shard_for(track_id);
+    Shard::Guard guard(shard, false);
+    auto found = shard.index.find(track_id);
+    return found == shard.index.end() ? std::shared_ptr<AudioTrack>() : shard.entries[found->second].track;
+}
+
+bool ShardedCache::contains(const std::string& track_id) const {
+    const Shard& shard = shard_for(track_id);
+    Shard::Guard guard(shard, false);
+    return shard.index.count(track_id) != 0;
+}
+
+bool ShardedCache::put(PointerWrapper<AudioTrack> track) {
+    if (!track) return false;
+    std::shared_ptr<AudioTrack> incoming(track.release());
+    const std::string& key = incoming->get_title();
+    Shard& shard = shard_for(key);
+    std::shared_ptr<AudioTrack> dropped;  // Released after the lock, in case this was the last holder
+    Shard::Guard guard(shard, true);
+    if (shard.capacity == 0) return false;
+
+    auto found = shard.index.find(key);
+    if (found != shard.index.end()) {
+        Shard::Entry& entry = shard.entries[found->second];
+        dropped.swap(entry.track);
+        entry.track = std::move(incoming);
+        entry.referenced.store(true, std::memory_order_relaxed);
+        shard.inserts.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    size_t slot = shard.used;
+    bool evicted = false;
+    if (shard.used < shard.capacity) {
+        ++shard.used;
+    } else {
+        // One sweep clears every bit it passes, so the loop ends within capacity + 1 steps
+        while (shard.entries[shard.hand].referenced.load(std::memory_order_relaxed)) {
+            shard.entries[shard.hand].referenced.store(false, std::memory_order_relaxed);
+            shard.hand = (shard.hand + 1) % shard.capacity;
+        }
+        slot = shard.hand;
+        shard.hand = (shard.hand + 1) % shard.capacity;
+        shard.index.erase(shard.entries[slot].key);
+        dropped.swap(shard.entries[slot].track);
+        shard.evictions.fetch_add(1, std::memory_order_relaxed);
+        evicted = true;
+    }
+    Shard::Entry& entry = shard.entries[slot];
+    entry.key = key;
+    entry.track = std::move(incoming);
+    entry.referenced.store(true, std::memory_order_relaxed);
+    shard.index.emplace(entry.key, slot);
+    shard.inserts.fetch_add(1, std::memory_order_relaxed);
+    return evicted;
+}
+
+void ShardedCache::clear() {
+    for (size_t i = 0; i < shard_total; ++i) {
+        Shard::Guard guard(shards[i], true);
+        shards[i].reset(shards[i].capacity);
+    }
+}
+
+size_t ShardedCache::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < shard_total; ++i) {
+        Shard::Guard guard(shards[i], false);
+        total += shards[i].used;
+    }
+    return total;
+}
+
+ShardedCache::Stats ShardedCache::stats() const {
+    Stats total = {0, 0, 0, 0, 0, 0};
+    for (size_t i = 0; i < shard_total; ++i) {
+        const Stats shard = shards[i].stats();
+        total.hits += shard.hits;
+        total.misses += shard.misses;
+        total.inserts += shard.inserts;
+        total.evictions += shard.evictions;
+        total.lock_acquisitions += shard.lock_acquisitions;
+        total.lock_contended += shard.lock_contended;
+    }
+    return total;
+}
+
+ShardedCache::Stats ShardedCache::shard_stats(size_t shard) const {
+    if (shard >= shard_total) {
+        Stats none = {0, 0, 0, 0, 0, 0};
+        return none;
+    }
+    return shards[shard].stats();
+}
+
+void ShardedCache::displayStatus() const {
+    std::cout << "[ShardedCache] Status: " << size() << "/" << total_capacity << " slots used in "
+              << shard_total << " shards\n";
+    for (size_t i = 0; i < shard_total; ++i) {
+        const Stats shard = shards[i].stats();
+        size_t used = 0;
+        {
+            Shard::Guard guard(shards[i], false);
+            used = shards[i].used;
+        }
+        std::cout << "  Shard " << i << ": " << used << "/" << shards[i].capacity << " slots, "
+                  << shard.hits << " hits, " << shard.misses << " misses, " << shard.evictions
+                  << " evictions, " << shard.lock_contended << "/" << shard.lock_acquisitions
+                  << " lock waits\n";
+    }
+}
@@ -0,0 +1,138 @@
+#include "TinyLFU.h"
+#include <algorithm>
+
+namespace {
+
+const size_t COUNTERS_PER_WORD = 16;     // 4 bits each
+const size_t MIN_COUNTERS = 64;          // Per row
+const unsigned MAX_COUNT = 15;
+const uint64_t HALVE_MASK = 0x7777777777777777ULL;  // Drops the bit shifted in from the next counter
+
+// 64-bit finaliser (splitmix64), so sequential intern ids spread over every row
+uint64_t mix(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+} // namespace
+
+const size_t TinyLFU::ROWS;
+
+TinyLFU::TinyLFU(size_t expected_entries)
+    : table(), row_words(0), counter_mask(0), sample(0), recorded(0), agings(0) {
+    const size_t entries = std::max<size_t>(expected_entries, 1);
+    const size_t counters = counters_for(entries);
+    row_words = counters / COUNTERS_PER_WORD;
+    counter_mask = counters - 1;
+    sample = 10 * entries;
+    table.assign(ROWS * row_words, 0);
+}
+
+size_t TinyLFU::counters_for(size_t entries) {
+    size_t counters = MIN_COUNTERS;
+    while (counters < 2 * entries) {
+        counters <<= 1;
+    }
+    return counters;
+}
+
+void TinyLFU::resize(size_t expected_entries) {
+    const size_t entries = std::max<size_t>(expected_entries, 1);
+    sample = 10 * entries;
+    const size_t counters = counters_for(entries);
+    const size_t old_counters = counter_mask + 1;
+    if (counters == old_counters) {
+        return;
+    }
+    std::vector<uint64_t> old_table(ROWS * (counters / COUNTERS_PER_WORD), 0);
+    old_table.swap(table);
+    const size_t old_words = row_words;
+    row_words = counters / COUNTERS_PER_WORD;
+    counter_mask = counters - 1;
+    // A key at p under the old mask sits at p & counter_mask now: copy or fold, keeping the maximum
+    const size_t span = std::max(counters, old_counters);
+    for (size_t row = 0; row < ROWS; ++row) {
+        for (size_t position = 0; position < span; ++position) {
+            const size_t from = position & (old_counters - 1);
+            const unsigned value = static_cast<unsigned>(
+                old_table[row * old_words + from / COUNTERS_PER_WORD] >> (4 * (from % COUNTERS_PER_WORD))) & MAX_COUNT;
+            const size_t to = position & counter_mask;
+            const unsigned current = counter(row, to);
+            if (value > current) {
+                table[row * row_words + to / COUNTERS_PER_WORD] +=
+                    static_cast<uint64_t>(value - current) << (4 * (to % COUNTERS_PER_WORD));
+            }
+        }
+    }
+}
+
+void TinyLFU::positions(uint64_t hash, size_t (&out)[ROWS]) const {
+    // Double hashing: row i uses h1 + i * h2, with h2 odd so the rows differ
+    const uint64_t step = (hash >> 32) | 1;
+    for (size_t row = 0; row < ROWS; ++row) {
+        out[row] = static_cast<size_t>(hash + row * step) & counter_mask;
+    }
+}
+
+unsigned TinyLFU::counter(size_t row, size_t position) const {
+    const uint64_t word = table[row * row_words + position / COUNTERS_PER_WORD];
+    return static_cast<unsigned>(word >> (4 * (position % COUNTERS_PER_WORD))) & MAX_COUNT;
+}
+
+void TinyLFU::record(InternedString key) {
+    size_t position[ROWS];
+    positions(mix(key.get_id()), position);
+    record_positions(position);
+}
+
+void TinyLFU::record_positions(const size_t (&position)[ROWS]) {
+    unsigned lowest = MAX_COUNT;
+    for (size_t row = 0; row < ROWS; ++row) {
+        lowest = std::min(lowest, counter(row, position[row]));
+    }
+    if (lowest < MAX_COUNT) {
+        // Conservative update: counters above the minimum already overcount this key
+        for (size_t row = 0; row < ROWS; ++row) {
+            if (counter(row, position[row]) == lowest) {
+                table[row * row_words + position[row] / COUNTERS_PER_WORD] +=
+                    static_cast<uint64_t>(1) << (4 * (position[row] % COUNTERS_PER_WORD));
+            }
+        }
+    }
+
+    if (++recorded >= sample) {
+        for (uint64_t& word : table) {
+            word = (word >> 1) & HALVE_MASK;
+        }
+        recorded = 0;
+        ++agings;
+    }
+}
+
+unsigned TinyLFU::estimate(const std::string& key) const {
+    InternedString interned;
+    // Never interned means never recorded
+    return InternedString::find(key, interned) ? estimate(interned) : 0;
+}
+
+unsigned TinyLFU::estimate(InternedString key) const {
+    size_t position[ROWS];
+    positions(mix(key.get_id()), position);
+    return estimate_positions(position);
+}
+
+unsigned TinyLFU::estimate_positions(const size_t (&position)[ROWS]) const {
+    unsigned lowest = MAX_COUNT;
+    for (size_t row = 0; row < ROWS; ++row) {
+        lowest = std::min(lowest, counter(row, position[row]));
+    }
+    return lowest;
+}
+
+void TinyLFU::clear() {
+    std::fill(table.begin(), table.end(), 0);
+    recorded = 0;
+}
@@ -0,0 +1,154 @@
+#include "TrackMetadataTable.h"
+
+namespace {
+
+const size_t LANES = 8;
+
+// (low <= value <= high) as one unsigned compare; low > high matches nothing
+inline uint32_t in_range(int32_t value, uint32_t low, uint32_t span) {
+    return static_cast<uint32_t>(value) - low <= span;
+}
+
+int64_t sum_column(const int32_t* column, size_t count) {
+    int64_t lanes[LANES] = {0};
+    size_t row = 0;
+    for (; row + LANES <= count; row += LANES) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            lanes[lane] += column[row + lane];
+        }
+    }
+    int64_t total = 0;
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        total += lanes[lane];
+    }
+    for (; row < count; ++row) {
+        total += column[row];
+    }
+    return total;
+}
+
+} // namespace
+
+void TrackMetadataTable::reserve(size_t rows) {
+    durations.reserve(rows);
+    bpms.reserve(rows);
+    formats.reserve(rows);
+    rates.reserve(rows);
+    bit_depths.reserve(rows);
+}
+
+void TrackMetadataTable::clear() {
+    durations.clear();
+    bpms.clear();
+    formats.clear();
+    rates.clear();
+    bit_depths.clear();
+}
+
+size_t TrackMetadataTable::append(TrackFormat format, int duration_seconds, int bpm, int rate, int bit_depth) {
+    durations.push_back(duration_seconds);
+    bpms.push_back(bpm);
+    formats.push_back(format);
+    rates.push_back(rate);
+    bit_depths.push_back(format == TrackFormat::WAV ? bit_depth : 0);
+    return durations.size() - 1;
+}
+
+bool TrackMetadataTable::parse_format(const std::string& type, TrackFormat& format) {
+    if (type == "MP3") {
+        format = TrackFormat::MP3;
+        return true;
+    }
+    if (type == "WAV") {
+        format = TrackFormat::WAV;
+        return true;
+    }
+    return false;
+}
+
+int64_t TrackMetadataTable::total_duration() const {
+    return sum_column(durations.data(), durations.size());
+}
+
+int64_t TrackMetadataTable::total_duration(const std::vector<uint32_t>& rows) const {
+    // A gather: not vectorised, but still one 4-byte load per row instead of two pointer hops
+    int64_t total = 0;
+    for (uint32_t row : rows) {
+        if (row < durations.size()) {
+            total += durations[row];
+        }
+    }
+    return total;
+}
+
+int64_t TrackMetadataTable::total_duration(TrackFormat format) const {
+    const int32_t* duration = durations.data();
+    const TrackFormat* kind = formats.data();
+    const size_t count = durations.size();
+    int64_t lanes[LANES] = {0};
+    size_t row = 0;
+    for (; row + LANES <= count; row += LANES) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            lanes[lane] += kind[row + lane] == format ? duration[row + lane] : 0;
+        }
+    }
+    int64_t total = 0;
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        total += lanes[lane];
+    }
+    for (; row < count; ++row) {
+        total += kind[row] == format ? duration[row] : 0;
+    }
+    return total;
+}
+
+size_t TrackMetadataTable::count_bpm_range(int low, int high) const {
+    if (low > high) {
+        return 0;
+    }
+    const uint32_t base = static_cast<uint32_t>(low);
+    const uint32_t span = static_cast<uint32_t>(high) - base;
+    const int32_t* bpm = bpms.data();
+    const size_t count = bpms.size();
+    // 32-bit lanes vectorise twice as wide; each sees at most count / LANES rows
+    uint32_t lanes[LANES] = {0};
+    size_t row = 0;
+    for (; row + LANES <= count; row += LANES) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            lanes[lane] += in_range(bpm[row + lane], base, span);
+        }
+    }
+    size_t matches = 0;
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        matches += lanes[lane];
+    }
+    for (; row < count; ++row) {
+        matches += in_range(bpm[row], base, span);
+    }
+    return matches;
+}
+
+std::vector<uint32_t> TrackMetadataTable::select_bpm_range(int low, int high) const {
+    std::vector<uint32_t> rows;
+    if (low > high) {
+        return rows;
+    }
+    const uint32_t base = static_cast<uint32_t>(low);
+    const uint32_t span = static_cast<uint32_t>(high) - base;
+    rows.resize(count_bpm_range(low, high));
+    // Branch-free compaction: always write, advance only on a match
+    uint32_t* out = rows.data();
+    size_t written = 0;
+    for (size_t row = 0; row < bpms.size() && written < rows.size(); ++row) {
+        out[written] = static_cast<uint32_t>(row);
+        written += in_range(bpms[row], base, span);
+    }
+    return rows;
+}
+
+double TrackMetadataTable::mean_bpm() const {
+    if (bpms.empty()) {
+        return 0.0;
+    }
+    return static_cast<double>(sum_column(bpms.data(), bpms.size())) / static_cast<double>(bpms.size());
+}
@@ -0,0 +1,81 @@
+#include "TwoQPolicy.h"
+#include <algorithm>
+
+void TwoQPolicy::attach(std::vector<CacheSlot>* slot_storage, size_t cache_capacity) {
+    EvictionPolicy::attach(slot_storage, cache_capacity);
+    a1in.clear();
+    am.clear();
+    a1out.clear();
+    kin = std::max<size_t>(1, cache_capacity / 4);
+    kout = std::max<size_t>(1, cache_capacity / 2);
+    pending_queue = A1IN;
+}
+
+void TwoQPolicy::onCapacityChange(size_t cache_capacity) {
+    EvictionPolicy::onCapacityChange(cache_capacity);
+    kin = std::max<size_t>(1, cache_capacity / 4);
+    kout = std::max<size_t>(1, cache_capacity / 2);
+}
+
+void TwoQPolicy::onMiss(const std::string& key) {
+    if (a1out.contains(key)) {
+        a1out.erase(key);
+        pending_queue = AM;
+    } else {
+        pending_queue = A1IN;
+    }
+}
+
+void TwoQPolicy::onInsert(size_t idx) {
+    if (pending_queue == AM) {
+        (*slots)[idx].tag = AM;
+        am.pushFront(*slots, idx);
+    } else {
+        (*slots)[idx].tag = A1IN;
+        a1in.pushFront(*slots, idx);
+    }
+    pending_queue = A1IN;
+}
+
+void TwoQPolicy::onHit(size_t idx) {
+    // A1in is a FIFO: correlated re-references inside it do not promote
+    if ((*slots)[idx].tag == AM && am.head() != idx) {
+        am.remove(*slots, idx);
+        am.pushFront(*slots, idx);
+    }
+}
+
+void TwoQPolicy::onRemove(size_t idx) {
+    CacheSlot& slot = (*slots)[idx];
+    if (slot.tag == A1IN) {
+        a1in.remove(*slots, idx);
+    } else if (slot.tag == AM) {
+        am.remove(*slots, idx);
+    }
+    slot.tag = NONE;
+}
+
+void TwoQPolicy::onMove(size_t from, size_t to) {
+    if ((*slots)[to].tag == A1IN) {
+        a1in.relink(*slots, from, to);
+    } else if ((*slots)[to].tag == AM) {
+        am.relink(*slots, from, to);
+    }
+}
+
+size_t TwoQPolicy::selectVictim() {
+    if (a1in.size() > kin || am.empty()) {
+        return a1in.tail();
+    }
+    return am.tail();
+}
+
+void TwoQPolicy::onEvict(size_t idx) {
+    if ((*slots)[idx].tag == A1IN) {
+        a1out.pushFront((*slots)[idx].getKey());
+        while (a1out.size() > kout) {
+            a1out.popBack();
+        }
+    }
+    onRemove(idx);
+}
@@ -1,39 +1,53 @@
 #include "WAVTrack.h"
 #include <iostream>
+#include <algorithm>
 
 WAVTrack::WAVTrack(const std::string& title, const std::vector<std::string>& artists, 
                    int duration, int bpm, int sample_rate, int bit_depth)
     : AudioTrack(title, artists, duration, bpm), sample_rate(sample_rate), bit_depth(bit_depth) {
 
-    std::cout << "WAVTrack created: " << sample_rate << "Hz/" << bit_depth << "bit" << std::endl;
+    construction_log() << "WAVTrack created: " << sample_rate << "Hz/" << bit_depth << "bit" << std::endl;
 }
 
-// ========== TODO: STUDENTS IMPLEMENT THESE VIRTUAL FUNCTIONS ==========
+// ========== VIRTUAL FUNCTION IMPLEMENTATIONS ==========
 
 void WAVTrack::load() {
-    // TODO: Implement realistic WAV loading simulation
-    // NOTE: Use exactly 2 spaces before the arrow (→) character
-
+    std::cout << "[WAVTrack::load] Loading WAV: \"" << title << "\" at "
+              << sample_rate << "Hz/" << bit_depth << "bit (uncompressed)...\n";
+    // Stereo PCM: duration * rate * bytes-per-sample * channels
+    long long size = static_cast<long long>(duration_seconds) * sample_rate * (bit_depth / 8) * 2;
+    std::cout << "  → Estimated file size: " << size << " bytes\n";
+    std::cout << "  → Fast loading due to uncompressed format.\n";
 }
 
 void WAVTrack::analyze_beatgrid() {
     std::cout << "[WAVTrack::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"\n";
-    // TODO: Implement WAV-specific beat detection analysis
-    // Requirements:
-    // 1. Print analysis message with track title
-    // 2. Calculate beats: (duration_seconds / 60.0) * bpm
-    // 3. Print number of beats and mention uncompressed precision
-    // should print "  → Estimated beats: <beats>  → Precision factor: 1.0 (uncompressed audio)"
+    int beats = estimate_beats();
+    double precision_factor = 1.0;
+    std::cout << "  → Estimated beats: " << beats
+              << "  → Precision factor: " << precision_factor << " (uncompressed audio)\n";
 }
 
 double WAVTrack::get_quality_score() const {
-    // TODO: Implement WAV quality scoring
-    // NOTE: Use exactly 2 spaces before each arrow (→) character
-    // NOTE: Cast beats to integer when printing
-    return 0.0; // Replace with your implementation
+    double score = 70.0;
+    if (sample_rate >= 96000) {
+        score += 15.0;
+    } else if (sample_rate >= 48000) {
+        score += 10.0;
+    }
+    if (bit_depth >= 24) {
+        score += 15.0;
+    } else if (bit_depth >= 16) {
+        score += 5.0;
+    }
+    return std::min(100.0, score);
+}
+
+size_t WAVTrack::audio_bytes() const {
+    return static_cast<size_t>(std::max(0, duration_seconds)) * static_cast<size_t>(std::max(0, sample_rate)) *
+           static_cast<size_t>(std::max(0, bit_depth / 8)) * 2;
 }
 
 PointerWrapper<AudioTrack> WAVTrack::clone() const {
-    // TODO: Implement the clone method
-    return PointerWrapper<AudioTrack>(nullptr); // Replace with your implementation
-}
\ No newline at end of file
+    return PointerWrapper<AudioTrack>(new WAVTrack(*this));
+}
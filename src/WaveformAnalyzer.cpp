@@ -0,0 +1,242 @@
+#include "WaveformAnalyzer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define WAVEFORM_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Sums over one window; crossings are counted between x[i-1] and x[i] for 0 < i < n
+struct Partial {
+    double sum_sq;
+    double peak;
+    size_t crossings;
+};
+
+typedef Partial (*Kernel)(const double* x, size_t n);
+
+Partial kernel_scalar(const double* x, size_t n) {
+    Partial p = {0.0, 0.0, 0};
+    if (n == 0) return p;
+    p.sum_sq = x[0] * x[0];
+    p.peak = std::fabs(x[0]);
+    for (size_t i = 1; i < n; ++i) {
+        const double v = x[i];
+        p.sum_sq += v * v;
+        p.peak = std::max(p.peak, std::fabs(v));
+        // Added, not branched on: sign changes in audio are close to random
+        p.crossings += static_cast<size_t>((x[i - 1] < 0.0) != (v < 0.0));
+    }
+    return p;
+}
+
+#ifdef WAVEFORM_X86_KERNELS
+
+// x[0] is folded in after the loop, so every vector step can compare
+// against its predecessor with one unaligned load at x + i - 1
+__attribute__((target("sse2")))
+Partial kernel_sse2(const double* x, size_t n) {
+    Partial p = {0.0, 0.0, 0};
+    if (n == 0) return p;
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    __m128d sum = zero;
+    __m128d peak = zero;
+    size_t i = 1;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d v = _mm_loadu_pd(x + i);
+        const __m128d prev = _mm_loadu_pd(x + i - 1);
+        sum = _mm_add_pd(sum, _mm_mul_pd(v, v));
+        peak = _mm_max_pd(peak, _mm_and_pd(v, abs_mask));
+        const __m128d flips = _mm_xor_pd(_mm_cmplt_pd(v, zero), _mm_cmplt_pd(prev, zero));
+        const int mask = _mm_movemask_pd(flips);
+        p.crossings += static_cast<size_t>((mask & 1) + (mask >> 1));
+    }
+    double sums[2];
+    double peaks[2];
+    _mm_storeu_pd(sums, sum);
+    _mm_storeu_pd(peaks, peak);
+    p.sum_sq = x[0] * x[0] + sums[0] + sums[1];
+    p.peak = std::max(std::fabs(x[0]), std::max(peaks[0], peaks[1]));
+    for (; i < n; ++i) {
+        p.sum_sq += x[i] * x[i];
+        p.peak = std::max(p.peak, std::fabs(x[i]));
+        p.crossings += static_cast<size_t>((x[i - 1] < 0.0) != (x[i] < 0.0));
+    }
+    return p;
+}
+
+// Every AVX2 CPU also has POPCNT; without it __builtin_popcount is a library call
+__attribute__((target("avx2,popcnt")))
+Partial kernel_avx2(const double* x, size_t n) {
+    Partial p = {0.0, 0.0, 0};
+    if (n == 0) return p;
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    // Two accumulator pairs hide the add latency
+    __m256d sum0 = zero, sum1 = zero;
+    __m256d peak0 = zero, peak1 = zero;
+    size_t i = 1;
+    for (; i + 8 <= n; i += 8) {
+        const __m256d v0 = _mm256_loadu_pd(x + i);
+        const __m256d v1 = _mm256_loadu_pd(x + i + 4);
+        const __m256d prev0 = _mm256_loadu_pd(x + i - 1);
+        const __m256d prev1 = _mm256_loadu_pd(x + i + 3);
+        sum0 = _mm256_add_pd(sum0, _mm256_mul_pd(v0, v0));
+        sum1 = _mm256_add_pd(sum1, _mm256_mul_pd(v1, v1));
+        peak0 = _mm256_max_pd(peak0, _mm256_and_pd(v0, abs_mask));
+        peak1 = _mm256_max_pd(peak1, _mm256_and_pd(v1, abs_mask));
+        const __m256d flips0 = _mm256_xor_pd(_mm256_cmp_pd(v0, zero, _CMP_LT_OQ),
+                                             _mm256_cmp_pd(prev0, zero, _CMP_LT_OQ));
+        const __m256d flips1 = _mm256_xor_pd(_mm256_cmp_pd(v1, zero, _CMP_LT_OQ),
+                                             _mm256_cmp_pd(prev1, zero, _CMP_LT_OQ));
+        p.crossings += static_cast<size_t>(__builtin_popcount(_mm256_movemask_pd(flips0)) +
+                                           __builtin_popcount(_mm256_movemask_pd(flips1)));
+    }
+    double sums[4];
+    double peaks[4];
+    _mm256_storeu_pd(sums, _mm256_add_pd(sum0, sum1));
+    _mm256_storeu_pd(peaks, _mm256_max_pd(peak0, peak1));
+    p.sum_sq = x[0] * x[0] + (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    p.peak = std::max(std::fabs(x[0]),
+                      std::max(std::max(peaks[0], peaks[1]), std::max(peaks[2], peaks[3])));
+    for (; i < n; ++i) {
+        p.sum_sq += x[i] * x[i];
+        p.peak = std::max(p.peak, std::fabs(x[i]));
+        p.crossings += static_cast<size_t>((x[i - 1] < 0.0) != (x[i] < 0.0));
+    }
+    return p;
+}
+
+#endif // WAVEFORM_X86_KERNELS
+
+WaveformAnalyzer::Isa detect_best_isa() {
+#ifdef WAVEFORM_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return WaveformAnalyzer::Isa::AVX2;
+    if (__builtin_cpu_supports("sse2")) return WaveformAnalyzer::Isa::SSE2;
+#endif
+    return WaveformAnalyzer::Isa::Scalar;
+}
+
+// -1 until the first analysis (or set_isa) picks a variant
+std::atomic<int> selected_isa(-1);
+
+Kernel kernel_for(WaveformAnalyzer::Isa isa) {
+    switch (isa) {
+#ifdef WAVEFORM_X86_KERNELS
+    case WaveformAnalyzer::Isa::AVX2: return kernel_avx2;
+    case WaveformAnalyzer::Isa::SSE2: return kernel_sse2;
+#endif
+    default:                          return kernel_scalar;
+    }
+}
+
+// Running totals across windows
+struct Accumulator {
+    double sum_sq = 0.0;
+    double peak = 0.0;
+    size_t crossings = 0;
+    size_t samples = 0;
+    bool has_last = false;
+    double last = 0.0;
+
+    void add(WaveformStats& stats, const Partial& p, const double* x, size_t n) {
+        if (n == 0) return;
+        if (has_last && (last < 0.0) != (x[0] < 0.0)) {
+            ++crossings;
+        }
+        sum_sq += p.sum_sq;
+        peak = std::max(peak, p.peak);
+        crossings += p.crossings;
+        samples += n;
+        has_last = true;
+        last = x[n - 1];
+        stats.energy_envelope.push_back(std::sqrt(p.sum_sq / static_cast<double>(n)));
+    }
+
+    void finish(WaveformStats& stats) const {
+        stats.samples = samples;
+        stats.peak = peak;
+        stats.rms = samples ? std::sqrt(sum_sq / static_cast<double>(samples)) : 0.0;
+        stats.crest_factor = stats.rms > 0.0 ? peak / stats.rms : 0.0;
+        stats.zero_crossing_rate =
+            samples > 1 ? static_cast<double>(crossings) / static_cast<double>(samples - 1) : 0.0;
+    }
+};
+
+WaveformStats analyze_with(Kernel kernel, const double* samples, size_t count, size_t window) {
+    WaveformStats stats;
+    stats.window = std::max<size_t>(1, window);
+    if (!samples) return stats;
+    stats.energy_envelope.reserve((count + stats.window - 1) / stats.window);
+    Accumulator acc;
+    for (size_t offset = 0; offset < count; offset += stats.window) {
+        const size_t n = std::min(stats.window, count - offset);
+        acc.add(stats, kernel(samples + offset, n), samples + offset, n);
+    }
+    acc.finish(stats);
+    return stats;
+}
+
+} // namespace
+
+WaveformStats WaveformAnalyzer::analyze(const WaveformBuffer& waveform, size_t window) {
+    if (waveform.format() == SampleFormat::Float64 || waveform.empty()) {
+        return analyze(static_cast<const double*>(waveform.raw()), waveform.size(), window);
+    }
+
+    // Compact formats: decode a window at a time, then run the same kernel
+    Kernel kernel = kernel_for(active_isa());
+    WaveformStats stats;
+    stats.window = std::max<size_t>(1, window);
+    stats.energy_envelope.reserve((waveform.size() + stats.window - 1) / stats.window);
+    std::vector<double> scratch(std::min(stats.window, waveform.size()));
+    Accumulator acc;
+    for (size_t offset = 0; offset < waveform.size(); offset += stats.window) {
+        const size_t n = waveform.read(offset, scratch.data(), stats.window);
+        acc.add(stats, kernel(scratch.data(), n), scratch.data(), n);
+    }
+    acc.finish(stats);
+    return stats;
+}
+
+WaveformStats WaveformAnalyzer::analyze(const double* samples, size_t count, size_t window) {
+    return analyze_with(kernel_for(active_isa()), samples, count, window);
+}
+
+WaveformStats WaveformAnalyzer::analyze_reference(const double* samples, size_t count, size_t window) {
+    return analyze_with(kernel_scalar, samples, count, window);
+}
+
+WaveformAnalyzer::Isa WaveformAnalyzer::active_isa() {
+    int isa = selected_isa.load(std::memory_order_relaxed);
+    if (isa < 0) {
+        isa = static_cast<int>(best_isa());
+        selected_isa.store(isa, std::memory_order_relaxed);
+    }
+    return static_cast<Isa>(isa);
+}
+
+WaveformAnalyzer::Isa WaveformAnalyzer::best_isa() {
+    static const Isa best = detect_best_isa();
+    return best;
+}
+
+void WaveformAnalyzer::set_isa(Isa isa) {
+    const Isa chosen = static_cast<int>(isa) > static_cast<int>(best_isa()) ? best_isa() : isa;
+    selected_isa.store(static_cast<int>(chosen), std::memory_order_relaxed);
+}
+
+const char* WaveformAnalyzer::isa_name(Isa isa) {
+    switch (isa) {
+    case Isa::AVX2: return "avx2";
+    case Isa::SSE2: return "sse2";
+    case Isa::Scalar:
+    default:        return "scalar";
+    }
+}
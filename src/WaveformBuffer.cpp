@@ -0,0 +1,274 @@
+#include "WaveformBuffer.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#ifndef WAVEFORM_SAMPLE_FORMAT
+#define WAVEFORM_SAMPLE_FORMAT Float64
+#endif
+
+namespace {
+
+std::atomic<size_t> allocation_count(0);
+std::atomic<size_t> allocated_bytes(0);
+std::atomic<size_t> share_count(0);
+std::atomic<int> default_sample_format(static_cast<int>(SampleFormat::WAVEFORM_SAMPLE_FORMAT));
+
+const double MU = 255.0;
+
+double clamp_unit(double x) {
+    return x < -1.0 ? -1.0 : (x > 1.0 ? 1.0 : x);
+}
+
+// Mu-law code: sign bit plus a 7-bit magnitude on the log curve
+int8_t mulaw_encode(double x) {
+    double magnitude = std::log1p(MU * std::fabs(x)) / std::log1p(MU);
+    int code = static_cast<int>(std::lround(magnitude * 127.0));
+    return static_cast<int8_t>(x < 0.0 ? -code : code);
+}
+
+// Decoding is a lookup; the table is built once, on first use
+double mulaw_decode(int8_t code) {
+    struct Table {
+        double values[256];
+        Table() {
+            for (int c = -128; c < 128; ++c) {
+                // -128 has no positive counterpart; it clamps to -1 like -127
+                double magnitude = std::min(1.0, (std::pow(1.0 + MU, std::abs(c) / 127.0) - 1.0) / MU);
+                values[c + 128] = c < 0 ? -magnitude : magnitude;
+            }
+        }
+    };
+    static const Table table;
+    return table.values[code + 128];
+}
+
+double decode(SampleFormat format, const unsigned char* samples, size_t i) {
+    switch (format) {
+    case SampleFormat::Float32:
+        return reinterpret_cast<const float*>(samples)[i];
+    case SampleFormat::Int16:
+        return reinterpret_cast<const int16_t*>(samples)[i] * (1.0 / 32767.0);
+    case SampleFormat::MuLaw8:
+        return mulaw_decode(reinterpret_cast<const int8_t*>(samples)[i]);
+    case SampleFormat::Float64:
+    default:
+        return reinterpret_cast<const double*>(samples)[i];
+    }
+}
+
+void encode(SampleFormat format, unsigned char* samples, size_t i, double x) {
+    x = clamp_unit(x);
+    switch (format) {
+    case SampleFormat::Float32:
+        reinterpret_cast<float*>(samples)[i] = static_cast<float>(x);
+        break;
+    case SampleFormat::Int16:
+        reinterpret_cast<int16_t*>(samples)[i] = static_cast<int16_t>(std::lround(x * 32767.0));
+        break;
+    case SampleFormat::MuLaw8:
+        reinterpret_cast<int8_t*>(samples)[i] = mulaw_encode(x);
+        break;
+    case SampleFormat::Float64:
+    default:
+        reinterpret_cast<double*>(samples)[i] = x;
+        break;
+    }
+}
+
+} // namespace
+
+WaveformBuffer::WaveformBuffer() : block(nullptr) {}
+
+WaveformBuffer::WaveformBuffer(size_t samples, SampleFormat format) : block(nullptr) {
+    if (samples > 0) {
+        block = allocate(samples, format);
+        // All-zero bytes decode to 0.0 in every format
+        std::memset(samples_of(block), 0, samples * sample_bytes(format));
+    }
+}
+
+WaveformBuffer::~WaveformBuffer() {
+    release(block);
+}
+
+WaveformBuffer::WaveformBuffer(const WaveformBuffer& other) : block(other.block) {
+    if (block) {
+        block->refs.fetch_add(1, std::memory_order_relaxed);
+        share_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+WaveformBuffer& WaveformBuffer::operator=(const WaveformBuffer& other) {
+    if (block == other.block) {
+        return *this;
+    }
+    // Take the new reference before dropping the old one
+    if (other.block) {
+        other.block->refs.fetch_add(1, std::memory_order_relaxed);
+        share_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    release(block);
+    block = other.block;
+    return *this;
+}
+
+WaveformBuffer::WaveformBuffer(WaveformBuffer&& other) noexcept : block(other.block) {
+    other.block = nullptr;
+}
+
+WaveformBuffer& WaveformBuffer::operator=(WaveformBuffer&& other) noexcept {
+    if (this != &other) {
+        release(block);
+        block = other.block;
+        other.block = nullptr;
+    }
+    return *this;
+}
+
+double WaveformBuffer::at(size_t i) const {
+    return decode(block->format, samples_of(block), i);
+}
+
+size_t WaveformBuffer::read(size_t offset, double* out, size_t count) const {
+    if (!block || !out || offset >= block->size) {
+        return 0;
+    }
+    count = std::min(count, block->size - offset);
+    // One switch per call, so each loop is a plain (vectorisable) conversion
+    const unsigned char* samples = samples_of(block);
+    switch (block->format) {
+    case SampleFormat::Float32: {
+        const float* in = reinterpret_cast<const float*>(samples) + offset;
+        for (size_t i = 0; i < count; ++i) out[i] = in[i];
+        break;
+    }
+    case SampleFormat::Int16: {
+        const int16_t* in = reinterpret_cast<const int16_t*>(samples) + offset;
+        for (size_t i = 0; i < count; ++i) out[i] = in[i] * (1.0 / 32767.0);
+        break;
+    }
+    case SampleFormat::MuLaw8:
+        for (size_t i = 0; i < count; ++i) out[i] = decode(SampleFormat::MuLaw8, samples, offset + i);
+        break;
+    case SampleFormat::Float64:
+    default:
+        std::memcpy(out, reinterpret_cast<const double*>(samples) + offset, count * sizeof(double));
+        break;
+    }
+    return count;
+}
+
+size_t WaveformBuffer::write(size_t offset, const double* in, size_t count) {
+    if (!block || !in || offset >= block->size) {
+        return 0;
+    }
+    count = std::min(count, block->size - offset);
+    unsigned char* samples = static_cast<unsigned char*>(edit_raw());
+    for (size_t i = 0; i < count; ++i) {
+        encode(block->format, samples, offset + i, in[i]);
+    }
+    return count;
+}
+
+const void* WaveformBuffer::raw() const {
+    return block ? samples_of(block) : nullptr;
+}
+
+void* WaveformBuffer::edit_raw() {
+    if (!block) {
+        return nullptr;
+    }
+    if (!unique()) {
+        Block* copy = allocate(block->size, block->format);
+        std::memcpy(samples_of(copy), samples_of(block), bytes());
+        release(block);
+        block = copy;
+    }
+    return samples_of(block);
+}
+
+bool WaveformBuffer::unique() const {
+    return block && block->refs.load(std::memory_order_acquire) == 1;
+}
+
+void WaveformBuffer::reset() {
+    release(block);
+    block = nullptr;
+}
+
+WaveformBuffer::Stats WaveformBuffer::stats() {
+    Stats s;
+    s.allocations = allocation_count.load(std::memory_order_relaxed);
+    s.bytes_allocated = allocated_bytes.load(std::memory_order_relaxed);
+    s.shares = share_count.load(std::memory_order_relaxed);
+    return s;
+}
+
+SampleFormat WaveformBuffer::default_format() {
+    return static_cast<SampleFormat>(default_sample_format.load(std::memory_order_relaxed));
+}
+
+void WaveformBuffer::set_default_format(SampleFormat format) {
+    default_sample_format.store(static_cast<int>(format), std::memory_order_relaxed);
+}
+
+size_t WaveformBuffer::sample_bytes(SampleFormat format) {
+    switch (format) {
+    case SampleFormat::Float32: return sizeof(float);
+    case SampleFormat::Int16:   return sizeof(int16_t);
+    case SampleFormat::MuLaw8:  return sizeof(int8_t);
+    case SampleFormat::Float64:
+    default:                    return sizeof(double);
+    }
+}
+
+const char* WaveformBuffer::format_name(SampleFormat format) {
+    switch (format) {
+    case SampleFormat::Float32: return "float32";
+    case SampleFormat::Int16:   return "int16";
+    case SampleFormat::MuLaw8:  return "mulaw8";
+    case SampleFormat::Float64:
+    default:                    return "float64";
+    }
+}
+
+bool WaveformBuffer::parse_format(const std::string& name, SampleFormat& format) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    const SampleFormat formats[] = {SampleFormat::Float64, SampleFormat::Float32,
+                                    SampleFormat::Int16, SampleFormat::MuLaw8};
+    for (SampleFormat candidate : formats) {
+        if (lower == format_name(candidate)) {
+            format = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+WaveformBuffer::Block* WaveformBuffer::allocate(size_t samples, SampleFormat format) {
+    static_assert(sizeof(Block) % alignof(double) == 0, "samples must follow the header aligned");
+    const size_t sample_size = samples * sample_bytes(format);
+    void* raw_block = ::operator new(sizeof(Block) + sample_size);
+    Block* b = static_cast<Block*>(raw_block);
+    new (&b->refs) std::atomic<size_t>(1);
+    b->size = samples;
+    b->format = format;
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(sample_size, std::memory_order_relaxed);
+    return b;
+}
+
+unsigned char* WaveformBuffer::samples_of(Block* b) {
+    return reinterpret_cast<unsigned char*>(b + 1);
+}
+
+void WaveformBuffer::release(Block* b) {
+    if (b && b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        b->refs.~atomic();
+        ::operator delete(b);
+    }
+}
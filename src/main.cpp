@@ -162,6 +162,8 @@ int main(int argc, char* argv[]) {
      * Command-line argument parsing
      * - If "-I" is provided as the first argument, run interactive DJ software
      * - If "-A" is provided as the second argument, enable play_all mode
+     * - If "-M" is provided as the first argument, print the cache sizing analysis
+     *   (LRU miss-ratio curves); an optional second argument exports them as CSV
      */
     bool run_software = false;
     bool play_all = false;
@@ -169,6 +171,12 @@ int main(int argc, char* argv[]) {
         run_software = true;
     }
 
+    if (argc > 1 && std::string(argv[1]) == "-M") {
+        DJSession analysis_session("Cache Sizing Analysis");
+        bool ok = analysis_session.analyze_cache_sizing(argc > 2 ? argv[2] : "");
+        return ok ? 0 : 1;
+    }
+
     if (argc > 2 && std::string(argv[2]) == "-A") {
         play_all = true;
     }